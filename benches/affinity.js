@@ -0,0 +1,56 @@
+const os = require('os');
+const { Tasklets } = require('../lib/index');
+const native = require('../lib/native');
+
+// Cache-heavy task: repeatedly sweeps a working set sized to stay in L2.
+// A worker that keeps its core keeps the set warm between tasks; a worker
+// that migrates pays for refilling the cache on the new core.
+const cacheHeavyTask = (bytes, sweeps) => {
+    const data = globalThis.__benchData && globalThis.__benchData.length === bytes / 8
+        ? globalThis.__benchData
+        : (globalThis.__benchData = new Float64Array(bytes / 8).fill(1));
+    let sum = 0;
+    for (let s = 0; s < sweeps; s++) {
+        for (let i = 0; i < data.length; i += 8) sum += data[i];
+    }
+    return sum;
+};
+
+async function measure(label, config) {
+    const pool = new Tasklets({ logging: 'warn', ...config });
+    const workers = pool.maxWorkers;
+    const taskCount = workers * 200;
+    const tasks = Array.from({ length: taskCount }, () => ({ task: cacheHeavyTask, args: [512 * 1024, 50] }));
+
+    await pool.runAll(tasks.slice(0, workers)); // warm-up: spawn workers, compile task
+
+    const start = process.hrtime.bigint();
+    await pool.runAll(tasks);
+    const ms = Number(process.hrtime.bigint() - start) / 1e6;
+
+    console.log(`${label.padEnd(32)} ${ms.toFixed(1).padStart(9)} ms  ${(taskCount / ms * 1000).toFixed(0).padStart(7)} tasks/s`);
+    await pool.terminate();
+    return ms;
+}
+
+async function runBenchmark() {
+    console.log('--- CPU Affinity Benchmark ---');
+
+    if (process.platform !== 'linux' || !native.load()) {
+        console.log('Native addon not available. Build it with `npm run build:native` (Linux only).');
+        return;
+    }
+
+    const cpus = os.cpus().length;
+    const maxWorkers = Math.max(1, cpus - 1);
+    console.log(`CPUs: ${cpus}, workers: ${maxWorkers}`);
+
+    const unpinned = await measure('Unpinned workers', { maxWorkers });
+    const pinned = await measure('Pinned workers', { maxWorkers, affinity: true });
+    const isolated = await measure('Pinned + isolated main thread', { maxWorkers, affinity: { isolateMainThread: true } });
+
+    console.log(`\nPinned vs unpinned:   ${(unpinned / pinned).toFixed(2)}x`);
+    console.log(`Isolated vs unpinned: ${(unpinned / isolated).toFixed(2)}x`);
+}
+
+runBenchmark().catch(console.error).finally(() => process.exit(0));
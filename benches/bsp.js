@@ -0,0 +1,108 @@
+const { Tasklets } = require('../lib/index');
+
+// Iterative 1-D stencil (three-point average) over a large grid, two ways:
+// runAll() every iteration, sending each partition plus its halo cells and
+// copying the new values back, and bsp(), where partitions stay in their
+// workers and exchange halos through shared memory.
+const SIZE = parseInt(process.argv[2], 10) || 4000000;
+const STEPS = parseInt(process.argv[3], 10) || 50;
+
+function initial() {
+    const grid = new Float64Array(SIZE);
+    for (let i = 0; i < SIZE; i++) grid[i] = i % 7 === 0 ? 100 : 0;
+    return grid;
+}
+
+function ranges(parts) {
+    return Array.from({ length: parts }, (_, p) => ({
+        start: Math.floor(p * SIZE / parts),
+        end: Math.floor((p + 1) * SIZE / parts)
+    }));
+}
+
+// Smooths cells [from, to) of `src` into `dst` at the same positions
+const kernel = (src, dst, from, to, last) => {
+    let change = 0;
+    for (let i = from; i < to; i++) {
+        if (i === 0 || i === last) {
+            dst[i] = src[i];
+            continue;
+        }
+        dst[i] = (src[i - 1] + src[i] + src[i + 1]) / 3;
+        const d = Math.abs(dst[i] - src[i]);
+        if (d > change) change = d;
+    }
+    return change;
+};
+
+async function resend(pool, parts) {
+    let grid = initial();
+    const step = (slice, offset, size) => {
+        // slice holds the partition plus one halo cell on each side that exists
+        const out = new Float64Array(slice.length);
+        const last = size - 1 - offset;
+        const from = offset === 0 ? 0 : 1;
+        const to = slice.length - (offset + slice.length === size ? 0 : 1);
+        let change = 0;
+        for (let i = from; i < to; i++) {
+            if (i === 0 || i === last) {
+                out[i] = slice[i];
+                continue;
+            }
+            out[i] = (slice[i - 1] + slice[i] + slice[i + 1]) / 3;
+            change = Math.max(change, Math.abs(out[i] - slice[i]));
+        }
+        return { values: out.subarray(from, to), change };
+    };
+    for (let s = 0; s < STEPS; s++) {
+        const results = await pool.runAll(parts.map(({ start, end }) => {
+            const lo = Math.max(0, start - 1);
+            return { task: step, args: [grid.slice(lo, Math.min(SIZE, end + 1)), lo, SIZE] };
+        }));
+        const next = new Float64Array(SIZE);
+        results.forEach((r, p) => next.set(r.values, parts[p].start));
+        grid = next;
+    }
+    return grid;
+}
+
+async function bulkSynchronous(pool, parts) {
+    const shared = [new SharedArrayBuffer(SIZE * 8), new SharedArrayBuffer(SIZE * 8)];
+    new Float64Array(shared[0]).set(initial());
+    const source = `(range, { step, shared }) => {
+        const kernel = ${kernel.toString()};
+        const src = new Float64Array(shared[step % 2]);
+        const dst = new Float64Array(shared[(step + 1) % 2]);
+        return kernel(src, dst, range.start, range.end, src.length - 1);
+    }`;
+    await pool.bsp(parts, source, { shared, maxSteps: STEPS });
+    return new Float64Array(shared[STEPS % 2]);
+}
+
+async function time(label, fn) {
+    const start = process.hrtime.bigint();
+    const grid = await fn();
+    const ms = Number(process.hrtime.bigint() - start) / 1e6;
+    console.log(`${label.padEnd(32)} ${ms.toFixed(0).padStart(7)} ms  ${(ms / STEPS).toFixed(2).padStart(7)} ms/step`);
+    return grid;
+}
+
+async function main() {
+    const pool = new Tasklets({ logging: 'warn' });
+    const parts = ranges(pool.maxWorkers);
+    console.log(`1-D stencil, ${SIZE.toLocaleString()} cells, ${STEPS} steps, ${parts.length} partitions\n`);
+    await pool.runAll(parts.map(() => () => 0)); // warm-up
+
+    const a = await time('runAll(), re-send per step', () => resend(pool, parts));
+    const b = await time('bsp(), worker-resident', () => bulkSynchronous(pool, parts));
+
+    let same = a.length === b.length;
+    for (let i = 0; same && i < a.length; i++) same = a[i] === b[i];
+    console.log(`\nResults identical: ${same}`);
+    await pool.terminate();
+}
+
+main().catch((err) => {
+    console.error(err);
+    process.exit(1);
+});
@@ -0,0 +1,61 @@
+const { PerformanceObserver, constants } = require('perf_hooks');
+const { Tasklets } = require('../lib/index');
+
+// Main-thread garbage produced by steady-state dispatch. A fixed number of
+// trivial tasks is kept in flight so the pool never idles; the GC observer
+// counts collections on the main thread only (workers have their own heaps).
+const TOTAL = 200000;
+const IN_FLIGHT = 512;
+
+const identity = (x) => x;
+
+const gcStats = { minor: 0, major: 0, ms: 0 };
+const observer = new PerformanceObserver((list) => {
+    for (const entry of list.getEntries()) {
+        const kind = entry.detail ? entry.detail.kind : entry.kind;
+        if (kind === constants.NODE_PERFORMANCE_GC_MAJOR) gcStats.major++;
+        else gcStats.minor++;
+        gcStats.ms += entry.duration;
+    }
+});
+
+async function runBenchmark() {
+    const pool = new Tasklets({ logging: 'warn' });
+    console.log(`--- GC Pressure: ${TOTAL} tasks, ${IN_FLIGHT} in flight, ${pool.maxWorkers} workers ---`);
+
+    await pool.runAll(Array.from({ length: pool.maxWorkers * 4 }, () => identity)); // warm-up
+
+    observer.observe({ entryTypes: ['gc'] });
+    const heapBefore = process.memoryUsage().heapUsed;
+    const start = process.hrtime.bigint();
+
+    let submitted = 0;
+    await new Promise((resolve, reject) => {
+        let completed = 0;
+        const next = () => {
+            if (submitted === TOTAL) return;
+            const n = submitted++;
+            pool.run(identity, n).then(() => {
+                if (++completed === TOTAL) resolve();
+                else next();
+            }, reject);
+        };
+        for (let i = 0; i < IN_FLIGHT; i++) next();
+    });
+
+    const ms = Number(process.hrtime.bigint() - start) / 1e6;
+    await new Promise(r => setImmediate(r)); // flush pending GC entries
+    observer.disconnect();
+
+    const per100k = (n) => (n / TOTAL * 100000).toFixed(1);
+    console.log(`Throughput:        ${(TOTAL / ms * 1000).toFixed(0)} tasks/s (${ms.toFixed(0)} ms)`);
+    console.log(`GC (per 100k):     ${per100k(gcStats.minor)} minor, ${per100k(gcStats.major)} major, ${per100k(gcStats.ms)} ms paused`);
+    console.log(`Heap delta:        ${((process.memoryUsage().heapUsed - heapBefore) / 1024 / 1024).toFixed(1)} MB`);
+
+    await pool.terminate();
+}
+
+runBenchmark().catch((err) => {
+    console.error(err);
+    process.exit(1);
+});
@@ -0,0 +1,83 @@
+const { Tasklets } = require('../lib/index');
+
+// GFLOP/s (2 x n^3 / time) of an n x n matrix product three ways: a naive
+// loop on the main thread, one runAll() task per row with plain arrays (as in
+// docs/examples/parallel/03-matrix-multiplication.js), and matmul().
+const N = parseInt(process.argv[2], 10) || 512;
+const FLOPS = 2 * N * N * N;
+
+function random(n) {
+    const data = new Float64Array(new SharedArrayBuffer(n * n * 8));
+    for (let i = 0; i < data.length; i++) data[i] = Math.random();
+    return { rows: n, cols: n, data };
+}
+
+function naive(A, B) {
+    const n = A.rows;
+    const c = new Float64Array(n * n);
+    for (let i = 0; i < n; i++) {
+        for (let j = 0; j < n; j++) {
+            let sum = 0;
+            for (let p = 0; p < n; p++) sum += A.data[i * n + p] * B.data[p * n + j];
+            c[i * n + j] = sum;
+        }
+    }
+    return c;
+}
+
+async function rowTasks(pool, A, B) {
+    const n = A.rows;
+    const matrixB = Array.from({ length: n }, (_, p) => Array.from(B.data.subarray(p * n, (p + 1) * n)));
+    const tasks = [];
+    for (let i = 0; i < n; i++) {
+        const rowA = Array.from(A.data.subarray(i * n, (i + 1) * n));
+        tasks.push({
+            task: (row, matrix) => {
+                const result = new Array(matrix[0].length).fill(0);
+                for (let j = 0; j < matrix[0].length; j++) {
+                    for (let p = 0; p < row.length; p++) result[j] += row[p] * matrix[p][j];
+                }
+                return result;
+            },
+            args: [rowA, matrixB]
+        });
+    }
+    return pool.runAll(tasks);
+}
+
+async function time(label, fn, reference) {
+    const start = process.hrtime.bigint();
+    const out = await fn();
+    const ms = Number(process.hrtime.bigint() - start) / 1e6;
+    const data = out.data || out;
+    let maxErr = 0;
+    for (let i = 0; i < reference.length; i += 97) {
+        const v = Array.isArray(data) ? data[Math.floor(i / N)][i % N] : data[i];
+        maxErr = Math.max(maxErr, Math.abs(v - reference[i]));
+    }
+    console.log(`${label.padEnd(28)} ${ms.toFixed(0).padStart(7)} ms  ${(FLOPS / ms / 1e6).toFixed(2).padStart(6)} GFLOP/s  (max error ${maxErr.toExponential(1)})`);
+}
+
+async function main() {
+    const pool = new Tasklets({ logging: 'warn' });
+    console.log(`Matrix multiplication ${N} x ${N}, ${pool.maxWorkers} workers\n`);
+
+    const A = random(N);
+    const B = random(N);
+    await pool.matmul(random(64), random(64)); // warm up the workers and the kernel
+
+    const start = process.hrtime.bigint();
+    const reference = naive(A, B);
+    const ms = Number(process.hrtime.bigint() - start) / 1e6;
+    console.log(`${'naive, main thread'.padEnd(28)} ${ms.toFixed(0).padStart(7)} ms  ${(FLOPS / ms / 1e6).toFixed(2).padStart(6)} GFLOP/s`);
+
+    await time('runAll, one task per row', () => rowTasks(pool, A, B), reference);
+    await time('matmul()', () => pool.matmul(A, B), reference);
+
+    await pool.terminate();
+}
+
+main().catch((err) => {
+    console.error(err);
+    process.exit(1);
+});
@@ -0,0 +1,43 @@
+const os = require('os');
+const { Tasklets } = require('../lib/index');
+
+// monteCarlo() throughput at 1, 2, 4, ... workers up to the CPU count. The
+// estimate must be identical at every worker count.
+const SAMPLES = parseInt(process.argv[2], 10) || 20000000;
+const SEED = 12345;
+
+const pi = (random) => {
+    const x = random();
+    const y = random();
+    return x * x + y * y <= 1 ? 4 : 0;
+};
+
+async function main() {
+    const cpus = os.cpus().length;
+    const counts = [];
+    for (let w = 1; w < cpus; w *= 2) counts.push(w);
+    counts.push(cpus);
+
+    console.log(`Monte Carlo estimate of pi, ${SAMPLES.toLocaleString()} samples\n`);
+    let baseline;
+    let reference;
+    for (const workers of counts) {
+        const pool = new Tasklets({ maxWorkers: workers, minWorkers: workers, logging: 'warn' });
+        await pool.monteCarlo(workers * 65536, pi, { seed: 1 }); // warm-up
+
+        const start = process.hrtime.bigint();
+        const result = await pool.monteCarlo(SAMPLES, pi, { seed: SEED });
+        const ms = Number(process.hrtime.bigint() - start) / 1e6;
+        await pool.terminate();
+
+        baseline = baseline || ms;
+        reference = reference === undefined ? result.mean : reference;
+        const rate = (SAMPLES / ms / 1e3).toFixed(1);
+        console.log(`${String(workers).padStart(3)} workers ${ms.toFixed(0).padStart(7)} ms  ${rate.padStart(7)} M samples/s  speedup ${(baseline / ms).toFixed(2)}x  mean ${result.mean}${result.mean === reference ? '' : '  MISMATCH'}`);
+    }
+}
+
+main().catch((err) => {
+    console.error(err);
+    process.exit(1);
+});
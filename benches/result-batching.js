@@ -0,0 +1,65 @@
+const { performance, monitorEventLoopDelay } = require('perf_hooks');
+const { Tasklets } = require('../lib/index');
+
+// Main-thread cost of result delivery with and without resultBatching. A
+// fixed number of trivial tasks is kept in flight, while a 1 ms timer stands
+// in for other work on the event loop (HTTP handlers); its lag shows how
+// much result handling delays that work.
+const TOTAL = 100000;
+const IN_FLIGHT = 512;
+
+const identity = (x) => x;
+
+function saturate(pool) {
+    return new Promise((resolve, reject) => {
+        let submitted = 0;
+        let completed = 0;
+        const onResult = () => {
+            if (++completed === TOTAL) resolve();
+            else next();
+        };
+        const next = () => {
+            if (submitted === TOTAL) return;
+            pool.run(identity, submitted++).then(onResult, reject);
+        };
+        for (let i = 0; i < IN_FLIGHT; i++) next();
+    });
+}
+
+async function measure(label, resultBatching) {
+    const pool = new Tasklets({ logging: 'warn', resultBatching });
+    await pool.runAll(Array.from({ length: pool.maxWorkers * 4 }, () => identity)); // warm-up
+
+    const lag = monitorEventLoopDelay({ resolution: 1 });
+    const ticker = setInterval(() => { }, 1);
+    lag.enable();
+    const elu = performance.eventLoopUtilization();
+    const start = process.hrtime.bigint();
+
+    await saturate(pool);
+
+    const ms = Number(process.hrtime.bigint() - start) / 1e6;
+    const busyMs = performance.eventLoopUtilization(elu).active;
+    lag.disable();
+    clearInterval(ticker);
+
+    const stats = pool.getStats().resultBatching;
+    console.log(`${label.padEnd(18)} ${(TOTAL / ms * 1000).toFixed(0).padStart(7)} tasks/s, ` +
+        `${(busyMs * 1000 / TOTAL).toFixed(2)} µs/task main thread, ` +
+        `loop delay p99 ${(lag.percentile(99) / 1e6).toFixed(2)} ms` +
+        (resultBatching ? `, avg batch ${stats.avgBatch.toFixed(1)}` : ''));
+    await pool.terminate();
+}
+
+async function runBenchmark() {
+    console.log(`--- Result Batching: ${TOTAL} tasks, ${IN_FLIGHT} in flight ---`);
+    for (let round = 0; round < 2; round++) {
+        await measure('per-result', false);
+        await measure('resultBatching', true);
+    }
+}
+
+runBenchmark().catch((err) => {
+    console.error(err);
+    process.exit(1);
+});
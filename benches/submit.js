@@ -0,0 +1,78 @@
+const { performance } = require('perf_hooks');
+const { Tasklets } = require('../lib/index');
+
+// Dispatch throughput of the promise API (run) vs. the callback API (submit)
+// for trivial tasks, where per-task overhead dominates. Both keep the same
+// number of tasks in flight so the pool never idles. When the workers are
+// the bottleneck (few cores) throughput converges, so the main thread's busy
+// time per task is reported as well: that is the cost submit() removes.
+const TOTAL = 100000;
+const IN_FLIGHT = 512;
+
+const identity = (x) => x;
+
+function viaRun(pool) {
+    return new Promise((resolve, reject) => {
+        let submitted = 0;
+        let completed = 0;
+        const onResult = () => {
+            if (++completed === TOTAL) resolve();
+            else next();
+        };
+        const next = () => {
+            if (submitted === TOTAL) return;
+            pool.run(identity, submitted++).then(onResult, reject);
+        };
+        for (let i = 0; i < IN_FLIGHT; i++) next();
+    });
+}
+
+function viaSubmit(pool) {
+    return new Promise((resolve, reject) => {
+        let submitted = 0;
+        let completed = 0;
+        const onResult = (err) => {
+            if (err) return reject(err);
+            if (++completed === TOTAL) resolve();
+            else next();
+        };
+        const next = () => {
+            if (submitted === TOTAL) return;
+            pool.submit(identity, [submitted++], onResult);
+        };
+        for (let i = 0; i < IN_FLIGHT; i++) next();
+    });
+}
+
+async function measure(label, pool, fn) {
+    const elu = performance.eventLoopUtilization();
+    const start = process.hrtime.bigint();
+    await fn(pool);
+    const ms = Number(process.hrtime.bigint() - start) / 1e6;
+    const busyMs = performance.eventLoopUtilization(elu).active;
+    console.log(`${label.padEnd(20)} ${(TOTAL / ms * 1000).toFixed(0).padStart(8)} tasks/s, ` +
+        `${(busyMs * 1000 / TOTAL).toFixed(2)} µs main-thread time per task`);
+    return busyMs;
+}
+
+async function runBenchmark() {
+    const pool = new Tasklets({ logging: 'warn' });
+    console.log(`--- Callback vs. Promise submission: ${TOTAL} tasks, ${IN_FLIGHT} in flight, ${pool.maxWorkers} workers ---`);
+
+    await pool.runAll(Array.from({ length: pool.maxWorkers * 4 }, () => identity)); // warm-up
+
+    // Alternate rounds to spread JIT warm-up and machine noise over both
+    const totals = { run: 0, submit: 0 };
+    for (let round = 0; round < 3; round++) {
+        totals.run += await measure('run() + Promise', pool, viaRun);
+        totals.submit += await measure('submit() + callback', pool, viaSubmit);
+    }
+    console.log(`Main-thread cost of submit(): ${(totals.submit / totals.run * 100).toFixed(0)}% of run()`);
+
+    await pool.terminate();
+}
+
+runBenchmark().catch((err) => {
+    console.error(err);
+    process.exit(1);
+});
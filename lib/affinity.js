@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file affinity.js
+ * @brief CPU affinity planning for worker threads (Linux, native addon)
+ */
+
+const fs = require('fs');
+const native = require('./native');
+
+class AffinityManager {
+    constructor(pool) {
+        this.pool = pool; // Reference to Tasklets instance
+        this.enabled = false;
+        this.native = null;
+        this.cpus = [];          // CPUs handed out to workers
+        this.mainCpu = null;     // CPU reserved for the main thread (isolateMainThread)
+        this.originalMainAffinity = null;
+    }
+
+    /**
+     * Accepts `true`, `false` or `{ cpus, isolateMainThread }`.
+     * Returns false (and stays disabled) when pinning is not available.
+     */
+    configure(options) {
+        this._restoreMainThread();
+        this.enabled = false;
+        this.cpus = [];
+
+        if (!options) return false;
+        const opts = options === true ? {} : options;
+
+        if (process.platform !== 'linux') {
+            this.pool._log('warn', 'CPU affinity is only supported on Linux. Ignoring affinity option.');
+            return false;
+        }
+
+        this.native = native.load();
+        if (!this.native || !this.native.affinitySupported) {
+            this.pool._log('warn', 'CPU affinity requested but the native addon is not built (run `npm run build:native`). Ignoring affinity option.');
+            return false;
+        }
+
+        if (this.originalMainAffinity === null) {
+            this.originalMainAffinity = this.native.getAffinity();
+        }
+
+        let cpus = Array.isArray(opts.cpus) ? opts.cpus.slice() : this.originalMainAffinity.slice();
+        cpus = cpus.filter(cpu => Number.isInteger(cpu) && cpu >= 0);
+        if (cpus.length === 0) {
+            this.pool._log('warn', 'CPU affinity set is empty. Ignoring affinity option.');
+            return false;
+        }
+
+        if (opts.isolateMainThread) {
+            if (cpus.length < 2) {
+                this.pool._log('warn', 'isolateMainThread needs at least 2 CPUs in the affinity set. Main thread left unpinned.');
+            } else {
+                this.mainCpu = cpus.shift();
+                // New threads inherit the creating thread's mask. Queueing any
+                // threadpool work starts the libuv threadpool right away, so
+                // its threads keep the full mask instead of the main CPU.
+                fs.stat(__filename, () => { });
+                this.native.setAffinity([this.mainCpu]);
+            }
+        }
+
+        this.cpus = cpus;
+        this.enabled = true;
+        return true;
+    }
+
+    /**
+     * Picks the CPU with the fewest pool workers already pinned to it.
+     */
+    assignCpu() {
+        if (!this.enabled) return undefined;
+
+        const load = new Map(this.cpus.map(cpu => [cpu, 0]));
+        for (const w of this.pool.workerPool) {
+            if (load.has(w.cpu)) load.set(w.cpu, load.get(w.cpu) + 1);
+        }
+
+        let best = this.cpus[0];
+        for (const [cpu, count] of load) {
+            if (count < load.get(best)) best = cpu;
+        }
+        return best;
+    }
+
+    getConfig() {
+        if (!this.enabled) return false;
+        return { cpus: this.cpus.slice(), mainCpu: this.mainCpu };
+    }
+
+    destroy() {
+        this._restoreMainThread();
+    }
+
+    _restoreMainThread() {
+        if (this.mainCpu !== null && this.native && this.originalMainAffinity) {
+            try {
+                this.native.setAffinity(this.originalMainAffinity);
+            } catch (err) {
+                this.pool._log('warn', `Failed to restore main thread affinity: ${err.message}`);
+            }
+        }
+        this.mainCpu = null;
+    }
+}
+
+module.exports = AffinityManager;
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file builtins/bsp.js
+ * @brief Worker side of tasklets.bsp(): owns one partition for a whole run
+ *
+ * The task keeps its partition for every superstep and blocks on a shared
+ * control word between steps. Control words:
+ *   RELEASED  supersteps the main thread has started (step s runs once it exceeds s)
+ *   ARRIVED   partitions that finished the current step; the last one wakes the main thread
+ *   STOP      set when the run ends or fails
+ *   STARTED   partitions whose task is running, so the main thread can tell
+ *             a slow first step from partitions that never got a worker
+ * Each partition's aggregate goes into its own slice of a shared
+ * Float64Array, so only numbers ever cross back per step.
+ */
+
+const RELEASED = 0;
+const ARRIVED = 1;
+const STOP = 2;
+const STARTED = 3;
+
+const steps = new Map(); // step source -> compiled function
+
+function compile(source) {
+    let step = steps.get(source);
+    if (!step) {
+        step = new Function(`return (${source})`)();
+        if (typeof step !== 'function') throw new Error('bsp() step must be a function');
+        steps.set(source, step);
+    }
+    return step;
+}
+
+function store(out, aggregate) {
+    if (aggregate === undefined || aggregate === null) {
+        out.fill(0);
+    } else if (typeof aggregate === 'number') {
+        out.fill(0);
+        out[0] = aggregate;
+    } else if (aggregate.length <= out.length) {
+        out.fill(0);
+        out.set(aggregate);
+    } else {
+        throw new Error(`bsp() step returned ${aggregate.length} values, aggregateSize is ${out.length}`);
+    }
+}
+
+module.exports = async function bsp(source, partition, index, count, shared, control, aggregates, aggregateSize, collect) {
+    const step = compile(source);
+    const ctl = new Int32Array(control);
+    const out = new Float64Array(aggregates, index * aggregateSize * 8, aggregateSize);
+    const ctx = { index, count, step: 0, shared };
+    Atomics.add(ctl, STARTED, 1);
+
+    for (let s = 0; ; s++) {
+        while (Atomics.load(ctl, RELEASED) === s && Atomics.load(ctl, STOP) === 0) {
+            Atomics.wait(ctl, RELEASED, s);
+        }
+        if (Atomics.load(ctl, STOP) !== 0) break;
+
+        ctx.step = s;
+        let aggregate = step(partition, ctx);
+        if (aggregate && typeof aggregate.then === 'function') aggregate = await aggregate;
+        store(out, aggregate);
+        if (Atomics.add(ctl, ARRIVED, 1) + 1 === count) Atomics.notify(ctl, ARRIVED);
+    }
+    return collect ? partition : null;
+};
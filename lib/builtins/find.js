@@ -0,0 +1,41 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file builtins/find.js
+ * @brief Worker side of tasklets.find(): scans one chunk for a match
+ *
+ * All chunks of a search share one Int32 flag. The first chunk to match
+ * claims it with a compare-and-swap; every scan reads it before each
+ * element, so the other workers stop within one predicate call.
+ */
+
+const predicates = new Map(); // predicate source -> compiled function
+
+function compile(source) {
+    let predicate = predicates.get(source);
+    if (!predicate) {
+        predicate = new Function(`return (${source})`)();
+        if (typeof predicate !== 'function') throw new Error('find() predicate must be a function');
+        predicates.set(source, predicate);
+    }
+    return predicate;
+}
+
+/**
+ * Returns `{ index, value }` for the match that won the flag, or null when
+ * the chunk has none or another chunk matched first.
+ */
+module.exports = function find(predicateSource, items, found) {
+    const predicate = compile(predicateSource);
+    const flag = new Int32Array(found);
+
+    for (let i = 0; i < items.length; i++) {
+        if (Atomics.load(flag, 0) !== 0) return null;
+        const value = items[i];
+        if (predicate(value, i)) {
+            return Atomics.compareExchange(flag, 0, 0, 1) === 0 ? { index: i, value } : null;
+        }
+    }
+    return null;
+};
@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file builtins/matmul.js
+ * @brief Worker side of tasklets.matmul(): one tile of C = A x B
+ *
+ * Matrices are row-major typed arrays over SharedArrayBuffers, so tasks
+ * only carry tile coordinates. The tile is computed in i-k-j order, which
+ * streams rows of B and C, blocked so a KC x NC panel of B stays in cache
+ * while every row of the tile uses it.
+ */
+
+const KC = 128; // Rows of B per panel
+const NC = 256; // Columns per panel: KC x NC doubles = 256 KB
+
+module.exports = function matmul(spec) {
+    const { a, b, c, k: K, n: N, i0, i1, j0, j1 } = spec;
+
+    for (let jj = j0; jj < j1; jj += NC) {
+        const jEnd = Math.min(jj + NC, j1);
+        for (let kk = 0; kk < K; kk += KC) {
+            const kEnd = Math.min(kk + KC, K);
+            for (let i = i0; i < i1; i++) {
+                const aRow = i * K;
+                const cRow = i * N;
+                for (let p = kk; p < kEnd; p++) {
+                    const aip = a[aRow + p];
+                    const bRow = p * N;
+                    let j = jj;
+                    // Unrolled by 4; the tail is finished below
+                    for (; j + 3 < jEnd; j += 4) {
+                        c[cRow + j] += aip * b[bRow + j];
+                        c[cRow + j + 1] += aip * b[bRow + j + 1];
+                        c[cRow + j + 2] += aip * b[bRow + j + 2];
+                        c[cRow + j + 3] += aip * b[bRow + j + 3];
+                    }
+                    for (; j < jEnd; j++) c[cRow + j] += aip * b[bRow + j];
+                }
+            }
+        }
+    }
+    return null;
+};
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file builtins/montecarlo.js
+ * @brief Worker side of tasklets.monteCarlo(): runs one chunk of samples
+ *
+ * Random numbers come from Philox4x32-10, a counter-based generator: each
+ * output block is a pure function of (key, counter). The key is the seed
+ * and the counter holds the chunk index and the block number, so every
+ * chunk has its own stream no matter which worker runs it.
+ */
+
+const M0 = 0xD2511F53;
+const M1 = 0xCD9E8D57;
+const W0 = 0x9E3779B9;
+const W1 = 0xBB67AE85;
+const TWO_POW_26 = 67108864;
+const TWO_POW_NEG_53 = 1 / 9007199254740992;
+
+const functions = new Map(); // fn source -> compiled function
+
+function compile(source) {
+    let fn = functions.get(source);
+    if (!fn) {
+        fn = new Function(`return (${source})`)();
+        if (typeof fn !== 'function') throw new Error('monteCarlo() fn must be a function');
+        functions.set(source, fn);
+    }
+    return fn;
+}
+
+// High 32 bits of the 64-bit product of two uint32s
+function mulhi(a, b) {
+    const al = a & 0xFFFF, ah = a >>> 16;
+    const bl = b & 0xFFFF, bh = b >>> 16;
+    const t = ah * bl + ((al * bl) >>> 16);
+    const w = (t & 0xFFFF) + al * bh;
+    return (ah * bh + (t >>> 16) + (w >>> 16)) >>> 0;
+}
+
+/**
+ * Philox4x32-10: encrypts `ctr` (4 x uint32) under `key` (2 x uint32) into
+ * `out`.
+ */
+function philox(ctr, key, out) {
+    let c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    let k0 = key[0], k1 = key[1];
+    for (let round = 0; round < 10; round++) {
+        const hi0 = mulhi(M0, c0), lo0 = Math.imul(M0, c0) >>> 0;
+        const hi1 = mulhi(M1, c2), lo1 = Math.imul(M1, c2) >>> 0;
+        c0 = (hi1 ^ c1 ^ k0) >>> 0;
+        c1 = lo1;
+        c2 = (hi0 ^ c3 ^ k1) >>> 0;
+        c3 = lo0;
+        k0 = (k0 + W0) >>> 0;
+        k1 = (k1 + W1) >>> 0;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+/**
+ * Returns a `random()` for one stream: uniform doubles in [0, 1) with 53
+ * random bits, two per Philox block.
+ */
+function createStream(key0, key1, stream) {
+    const key = [key0 >>> 0, key1 >>> 0];
+    const ctr = new Uint32Array([0, 0, stream >>> 0, Math.floor(stream / 4294967296) >>> 0]);
+    const block = new Uint32Array(4);
+    let next = 4;
+    return function random() {
+        if (next === 4) {
+            philox(ctr, key, block);
+            if (++ctr[0] === 0) ctr[1]++;
+            next = 0;
+        }
+        const hi = block[next++] >>> 5;
+        const lo = block[next++] >>> 6;
+        return (hi * TWO_POW_26 + lo) * TWO_POW_NEG_53;
+    };
+}
+
+/**
+ * Calls fn(random, i) for samples start .. start + count - 1 and returns
+ * their count, mean and sum of squared deviations (Welford).
+ */
+function monteCarlo(source, key0, key1, chunk, start, count) {
+    const fn = compile(source);
+    const random = createStream(key0, key1, chunk);
+    let mean = 0;
+    let m2 = 0;
+    for (let i = 0; i < count; i++) {
+        const x = fn(random, start + i);
+        if (typeof x !== 'number') throw new Error(`monteCarlo() fn must return a number, got ${typeof x}`);
+        const delta = x - mean;
+        mean += delta / (i + 1);
+        m2 += delta * (x - mean);
+    }
+    return { count, mean, m2 };
+}
+
+module.exports = monteCarlo;
+module.exports.philox = philox;
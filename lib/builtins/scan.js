@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file builtins/scan.js
+ * @brief Worker side of tasklets.scan(): regex matches in one chunk
+ *
+ * A chunk is a nominal byte range [start, end) of the input. In line mode
+ * both edges move forward to the next line start, so neighbouring chunks
+ * split at the same newline and no line is scanned twice. In overlap mode
+ * the chunk is scanned up to `end + overlap`, but only matches starting
+ * before `end` are reported; the next chunk reports the rest.
+ *
+ * Each chunk also carries `context` bytes before its start (`overlap` of
+ * them, or the newline before a line-mode chunk). Matching starts at the
+ * chunk's first byte, but \b, ^ and lookbehinds see the real preceding
+ * text instead of a false start of input.
+ */
+
+const fs = require('fs');
+
+const NEWLINE = 0x0A;
+const READ_BLOCK = 64 * 1024;
+const patterns = new Map(); // 'flags/source' -> RegExp
+
+function compile(source, flags) {
+    const key = `${flags}/${source}`;
+    let re = patterns.get(key);
+    if (!re) {
+        re = new RegExp(source, flags);
+        patterns.set(key, re);
+    }
+    return re;
+}
+
+/**
+ * Offset just past the first newline at or after `pos` in the file, or
+ * `size` when there is none.
+ */
+function nextLineStart(fd, pos, size) {
+    const block = Buffer.allocUnsafe(READ_BLOCK);
+    while (pos < size) {
+        const n = fs.readSync(fd, block, 0, Math.min(READ_BLOCK, size - pos), pos);
+        if (n <= 0) break;
+        const nl = block.indexOf(NEWLINE);
+        if (nl !== -1 && nl < n) return pos + nl + 1;
+        pos += n;
+    }
+    return size;
+}
+
+/**
+ * Reads the bytes of a file chunk, aligned as described above.
+ */
+function readChunk(spec) {
+    const fd = fs.openSync(spec.path, 'r');
+    try {
+        const size = fs.fstatSync(fd).size;
+        let from = spec.start;
+        let to = Math.min(spec.end, size);
+        let reportEnd = to;
+        if (spec.overlap === null) {
+            if (from > 0) from = nextLineStart(fd, from - 1, size);
+            if (to < size) to = nextLineStart(fd, to - 1, size);
+            reportEnd = to;
+        } else {
+            to = Math.min(to + spec.overlap, size);
+        }
+
+        const context = Math.min(from, spec.overlap === null ? 1 : spec.overlap);
+        const origin = from - context;
+        const bytes = Buffer.allocUnsafe(Math.max(to - origin, 0));
+        let read = 0;
+        while (read < bytes.length) {
+            const n = fs.readSync(fd, bytes, read, bytes.length - read, origin + read);
+            if (n <= 0) break;
+            read += n;
+        }
+        return { bytes: bytes.subarray(0, read), base: from, reportEnd, context };
+    } finally {
+        fs.closeSync(fd);
+    }
+}
+
+module.exports = function scan(spec) {
+    const re = compile(spec.source, spec.flags);
+    let { bytes, base, reportEnd, context } = spec.path ? readChunk(spec) : spec;
+    const buf = Buffer.from(bytes.buffer, bytes.byteOffset, bytes.length);
+    const utf8 = spec.encoding === 'utf8';
+    let origin = base - context; // Input offset of buf[0]
+    let head = 0;
+
+    // UTF-8 cuts at arbitrary bytes can fall mid-character. Context starts
+    // at the next character; a chunk starting mid-character leaves those
+    // bytes to the previous chunk, which scans past its end.
+    if (utf8) {
+        while (head < context && (buf[head] & 0xC0) === 0x80) head++;
+        origin += head;
+        if (spec.overlap !== null && base > 0) {
+            let skip = context;
+            while (skip < buf.length && (buf[skip] & 0xC0) === 0x80) skip++;
+            base += skip - context;
+        }
+    }
+
+    const text = buf.toString(spec.encoding, head);
+    const offsets = [];
+    const matches = [];
+
+    // latin1 maps bytes 1:1 to characters; for UTF-8 byte offsets are
+    // counted forward from the previous match
+    const start = utf8 ? buf.toString('utf8', head, head + base - origin).length : base - origin;
+    let charPos = start;
+    let bytePos = base - origin;
+    re.lastIndex = start;
+    let m;
+    while ((m = re.exec(text)) !== null) {
+        if (utf8) {
+            bytePos += Buffer.byteLength(text.slice(charPos, m.index), 'utf8');
+            charPos = m.index;
+        } else {
+            bytePos = m.index;
+        }
+        const offset = origin + bytePos;
+        if (offset >= reportEnd) break;
+        offsets.push(offset);
+        matches.push(m[0]);
+        if (m[0].length === 0) re.lastIndex++; // Step over empty matches
+    }
+    return { offsets, matches };
+};
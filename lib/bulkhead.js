@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file bulkhead.js
+ * @brief Per-task-type concurrency limits (bulkheads)
+ */
+
+class BulkheadManager {
+    constructor(pool) {
+        this.pool = pool; // Reference to Tasklets instance
+        this.enabled = false;
+        this.bulkheads = new Map(); // type -> { maxConcurrency, active, peak, admitted, held }
+    }
+
+    /**
+     * `{ [type]: maxConcurrency }`. Reconfiguring a type keeps its counters;
+     * `false` removes every bulkhead.
+     */
+    configure(options) {
+        if (!options) {
+            this.enabled = false;
+            this.bulkheads.clear();
+            return;
+        }
+        for (const [type, max] of Object.entries(options)) {
+            this.setLimit(type, max);
+        }
+    }
+
+    /**
+     * Registers a limit given on the task itself. A configured limit wins.
+     */
+    addTaskLimit(type, max) {
+        if (!this.bulkheads.has(type)) this.setLimit(type, max);
+    }
+
+    setLimit(type, max) {
+        if (!Number.isInteger(max) || max < 1) {
+            throw new Error('maxConcurrency must be a positive integer');
+        }
+        const bulkhead = this.bulkheads.get(type);
+        if (bulkhead) bulkhead.maxConcurrency = max;
+        else this.bulkheads.set(type, { maxConcurrency: max, active: 0, peak: 0, admitted: 0, held: 0 });
+        this.enabled = true;
+    }
+
+    /**
+     * The bulkhead of the task's type when it has no free slot, or null.
+     * Counts each task as held at most once.
+     */
+    heldBy(task) {
+        const bulkhead = this.bulkheads.get(task.type);
+        if (!bulkhead || bulkhead.active < bulkhead.maxConcurrency) return null;
+        if (!task.bulkheadHeld) {
+            task.bulkheadHeld = true;
+            bulkhead.held++;
+        }
+        return bulkhead;
+    }
+
+    /**
+     * How many tasks parked on `bulkhead` may be requeued now.
+     */
+    room(bulkhead) {
+        return this.enabled ? bulkhead.maxConcurrency - bulkhead.active : Infinity;
+    }
+
+    // Slots free up when tasks finish, which reprocesses the queue anyway
+    wakeIn() {
+        return Infinity;
+    }
+
+    acquire(task) {
+        const bulkhead = this.bulkheads.get(task.type);
+        if (!bulkhead) return;
+        bulkhead.active++;
+        bulkhead.admitted++;
+        if (bulkhead.active > bulkhead.peak) bulkhead.peak = bulkhead.active;
+        task.bulkhead = bulkhead;
+    }
+
+    release(task) {
+        task.bulkhead.active--;
+        task.bulkhead = null;
+    }
+
+    getStats() {
+        const stats = {};
+        for (const [type, b] of this.bulkheads) {
+            stats[type] = {
+                maxConcurrency: b.maxConcurrency,
+                active: b.active,
+                peak: b.peak,
+                utilization: b.active / b.maxConcurrency,
+                admitted: b.admitted,
+                held: b.held
+            };
+        }
+        return stats;
+    }
+}
+
+module.exports = BulkheadManager;
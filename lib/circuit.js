@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file circuit.js
+ * @brief Per-task-type circuit breakers
+ *
+ * closed    -> tasks flow; outcomes are counted in a rolling window
+ * open      -> tasks of the type are rejected on the main thread
+ * half-open -> after `openMs`, a few probe tasks are let through; one
+ *              success closes the circuit, one failure opens it again
+ */
+
+const BUCKET_MS = 1000;
+const UNNAMED = 'anonymous'; // Type of tasks without a name (see Tasklets._taskType)
+
+// Unrelated inline tasks share the anonymous type, and each builtin (find,
+// scan, matmul...) runs every caller's function under one type; one failing
+// caller must not open a circuit for all the others
+function exempt(task) {
+    return task.type === UNNAMED || task.task.startsWith('BUILTIN:');
+}
+
+class CircuitManager {
+    constructor(pool) {
+        this.pool = pool; // Reference to Tasklets instance
+        this.enabled = false;
+        this.failureThreshold = 0.5; // Failure rate that opens the circuit
+        this.minRequests = 20;       // Outcomes needed in the window before judging
+        this.windowMs = 10000;
+        this.openMs = 5000;          // Time open before probing
+        this.halfOpenProbes = 1;
+        this.circuits = new Map();
+    }
+
+    /**
+     * Accepts `true`, `false` or `{ failureThreshold, minRequests, windowMs,
+     * openMs, halfOpenProbes }`. Disabling forgets all circuit state.
+     */
+    configure(options) {
+        if (!options) {
+            this.enabled = false;
+            this.circuits.clear();
+            return;
+        }
+        const opts = options === true ? {} : options;
+        if (opts.failureThreshold !== undefined) this.failureThreshold = opts.failureThreshold;
+        if (opts.minRequests !== undefined) this.minRequests = opts.minRequests;
+        if (opts.windowMs !== undefined) this.windowMs = opts.windowMs;
+        if (opts.openMs !== undefined) this.openMs = opts.openMs;
+        if (opts.halfOpenProbes !== undefined) this.halfOpenProbes = opts.halfOpenProbes;
+        this.enabled = true;
+    }
+
+    /**
+     * Admission check for a new task. Moves an open circuit to half-open once
+     * `openMs` has passed and marks the admitted task as a probe.
+     */
+    admit(task) {
+        if (exempt(task)) return true;
+        const circuit = this.circuits.get(task.type);
+        if (!circuit || circuit.state === 'closed') return true;
+
+        if (circuit.state === 'open') {
+            if (Date.now() - circuit.openedAt < this.openMs) {
+                circuit.rejected++;
+                return false;
+            }
+            this._transition(task.type, circuit, 'half-open');
+        }
+
+        if (circuit.probes >= this.halfOpenProbes) {
+            circuit.rejected++;
+            return false;
+        }
+        circuit.probes++;
+        task.probe = true;
+        return true;
+    }
+
+    /**
+     * Dispatch check for a queued task: only probes leave the queue while
+     * the circuit is not closed.
+     */
+    canDispatch(task) {
+        if (exempt(task)) return true;
+        const circuit = this.circuits.get(task.type);
+        if (!circuit || circuit.state === 'closed' || task.probe) return true;
+        circuit.rejected++;
+        return false;
+    }
+
+    isClosed(type) {
+        const circuit = this.circuits.get(type);
+        return !circuit || circuit.state === 'closed';
+    }
+
+    record(task, ok) {
+        if (exempt(task)) return;
+        const circuit = this._circuit(task.type);
+
+        if (task.probe) {
+            task.probe = false;
+            circuit.probes--;
+            if (circuit.state === 'half-open') {
+                if (ok) this._transition(task.type, circuit, 'closed');
+                else this._open(task.type, circuit);
+            }
+            return;
+        }
+        // Late results of tasks admitted before the circuit opened
+        if (circuit.state !== 'closed') return;
+
+        const bucket = this._bucket(circuit);
+        if (ok) bucket.successes++;
+        else bucket.failures++;
+        if (ok) return;
+
+        let successes = 0;
+        let failures = 0;
+        for (const b of circuit.buckets) {
+            successes += b.successes;
+            failures += b.failures;
+        }
+        const total = successes + failures;
+        if (total >= this.minRequests && failures / total >= this.failureThreshold) {
+            this._open(task.type, circuit);
+        }
+    }
+
+    /**
+     * Frees the probe slot of a task that was dropped before it ran.
+     */
+    releaseProbe(task) {
+        if (!task.probe) return;
+        task.probe = false;
+        this._circuit(task.type).probes--;
+    }
+
+    rejectionError(task) {
+        return new Error(`Circuit open for task type ${task.type}`);
+    }
+
+    getStats() {
+        const stats = {};
+        for (const [type, circuit] of this.circuits) {
+            let successes = 0;
+            let failures = 0;
+            this._expire(circuit);
+            for (const b of circuit.buckets) {
+                successes += b.successes;
+                failures += b.failures;
+            }
+            stats[type] = {
+                state: circuit.state,
+                failureRate: successes + failures > 0 ? failures / (successes + failures) : 0,
+                rejected: circuit.rejected,
+                opened: circuit.opened
+            };
+        }
+        return stats;
+    }
+
+    _open(type, circuit) {
+        circuit.openedAt = Date.now();
+        circuit.opened++;
+        this._transition(type, circuit, 'open');
+    }
+
+    _transition(type, circuit, state) {
+        circuit.state = state;
+        if (state !== 'half-open') circuit.buckets = [];
+        this.pool._log(state === 'open' ? 'warn' : 'info', `Circuit for ${type} is now ${state}`);
+        this.pool.emit(state === 'closed' ? 'circuit:close' : `circuit:${state}`, { type });
+    }
+
+    _circuit(type) {
+        let circuit = this.circuits.get(type);
+        if (!circuit) {
+            circuit = { state: 'closed', buckets: [], openedAt: 0, probes: 0, rejected: 0, opened: 0 };
+            this.circuits.set(type, circuit);
+        }
+        return circuit;
+    }
+
+    _bucket(circuit) {
+        const now = Date.now();
+        const last = circuit.buckets[circuit.buckets.length - 1];
+        if (last && now - last.start < BUCKET_MS) return last;
+        this._expire(circuit);
+        const bucket = { start: now, successes: 0, failures: 0 };
+        circuit.buckets.push(bucket);
+        return bucket;
+    }
+
+    _expire(circuit) {
+        const cutoff = Date.now() - this.windowMs;
+        while (circuit.buckets.length > 0 && circuit.buckets[0].start + BUCKET_MS <= cutoff) {
+            circuit.buckets.shift();
+        }
+    }
+}
+
+module.exports = CircuitManager;
@@ -0,0 +1,43 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file clock.js
+ * @brief Monotonic wall clock and per-thread CPU clock (native or JS fallback)
+ *
+ * Loaded by both the main thread and workers. All readings are milliseconds
+ * as doubles. `now()` readings from different threads are comparable: the
+ * native clock is CLOCK_MONOTONIC and the fallback is anchored to
+ * `performance.timeOrigin`, which differs per thread.
+ */
+
+const { performance } = require('perf_hooks');
+const native = require('./native');
+
+const binding = native.load();
+const hasNativeClocks = !!(binding && binding.clocksSupported);
+
+const now = hasNativeClocks
+    ? binding.now
+    : () => performance.timeOrigin + performance.now();
+
+// process.threadCpuUsage() (Node >= 23.9) is the only JS source of per-thread
+// CPU time; process.cpuUsage() covers every thread and would be misleading.
+let threadCpuTime = null;
+if (hasNativeClocks) {
+    threadCpuTime = binding.threadCpuTime;
+} else if (typeof process.threadCpuUsage === 'function') {
+    threadCpuTime = () => {
+        const usage = process.threadCpuUsage();
+        return (usage.user + usage.system) / 1000;
+    };
+}
+
+const cycles = binding && binding.rdtscSupported ? binding.rdtsc : null;
+
+module.exports = {
+    now,
+    threadCpuTime,
+    cycles,
+    source: hasNativeClocks ? 'native' : 'performance'
+};
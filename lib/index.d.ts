@@ -1,3 +1,5 @@
+import { EventEmitter } from 'events';
+
 export interface TaskletsConfig {
   maxWorkers?: number | 'auto';          // Number of worker threads (or 'auto' for CPU count)
   minWorkers?: number;                   // Minimum workers to keep alive
@@ -8,6 +10,109 @@ export interface TaskletsConfig {
   adaptive?: boolean;                    // Enable adaptive mode for auto-scaling
   maxMemory?: number;                    // Max memory usage in % (0-100). Safety limit (1 worker) at 5% free RAM.
   allowedModules?: string[];             // Optional allowlist for paths allowed in MODULE: prefix
+  affinity?: boolean | AffinityOptions;  // Pin workers to CPUs (Linux, requires `npm run build:native`)
+  retry?: RetryBudgetOptions;            // Pool-wide retry budget
+  circuitBreaker?: boolean | CircuitBreakerOptions; // Per-task-type circuit breakers (default: off)
+  rateLimit?: false | RateLimitOptions;  // Token buckets per task type / tenant
+  bulkheads?: false | Record<string, number>; // Max concurrent tasks per task type
+  timeSlicing?: boolean | TimeSlicingOptions; // Let sliced tasks share workers
+  resultBatching?: boolean | ResultBatchingOptions; // Deliver results in batches from setImmediate
+}
+
+export interface ResultBatchingOptions {
+  maxBatch?: number;                     // Deliver at once when this many results are pending (default: 256)
+}
+
+export interface ResultBatchingStats {
+  batches: number;
+  delivered: number;                     // Results delivered through batches
+  largestBatch: number;
+  avgBatch: number;
+}
+
+export interface TimeSlicingOptions {
+  maxConcurrentPerWorker?: number;       // Tasks a worker may multiplex (default: 4)
+  quantumMs?: number;                    // Slice length before tasklet.yield() parks a task (default: 10)
+}
+
+declare global {
+  /** Available inside worker tasks. */
+  const tasklet: {
+    /** Cooperative checkpoint for sliced tasks; see TimeSlicingOptions. */
+    yield(): Promise<void>;
+    /** True once the pool no longer needs this task's result (see Tasklets.any). */
+    readonly cancelled: boolean;
+    /** Throws 'Task cancelled' when `cancelled` is true. */
+    throwIfCancelled(): void;
+  };
+}
+
+export type RateLimit = number | { rate: number; burst?: number }; // rate in tasks per second
+
+export interface RateLimitOptions {
+  perType?: Record<string, RateLimit>;
+  perTenant?: Record<string, RateLimit>; // '*' = a separate bucket for every other tenant
+}
+
+export interface BulkheadStats {
+  maxConcurrency: number;
+  active: number;
+  peak: number;
+  utilization: number;                   // active / maxConcurrency
+  admitted: number;
+  held: number;                          // Tasks that waited for a slot at least once
+}
+
+export interface RateLimitStats {
+  rate: number;
+  burst: number;
+  tokens: number;
+  admitted: number;
+  held: number;                          // Tasks that waited for a token at least once
+}
+
+export interface CircuitBreakerOptions {
+  failureThreshold?: number;             // Failure rate that opens the circuit (default: 0.5)
+  minRequests?: number;                  // Outcomes in the window before judging (default: 20)
+  windowMs?: number;                     // Rolling window (default: 10000)
+  openMs?: number;                       // Time open before half-open probing (default: 5000)
+  halfOpenProbes?: number;               // Probe tasks let through while half-open (default: 1)
+}
+
+export interface CircuitStats {
+  state: 'closed' | 'open' | 'half-open';
+  failureRate: number;                   // Over the current window (0 while open)
+  rejected: number;                      // Tasks failed fast by this circuit
+  opened: number;                        // Times the circuit has opened
+}
+
+export interface RetryBudgetOptions {
+  budget?: number;                       // Max retries as a fraction of first attempts in the window (default: 0.2)
+  minRetriesPerWindow?: number;          // Retries always allowed per window (default: 10)
+  windowMs?: number;                     // Budget window (default: 10000)
+}
+
+export interface RetryPolicy {
+  attempts?: number;                     // Total attempts including the first (default: 3)
+  baseDelay?: number;                    // Minimum wait before a retry in ms (default: 0)
+  maxDelay?: number;                     // Maximum wait before a retry in ms (default: 30000)
+  backoff?: number;                      // Multiplier when jitter is disabled (default: 1)
+  jitter?: boolean;                      // Decorrelated jitter (default: true)
+  differentWorker?: boolean;             // Prefer another worker for retries (default: true)
+  budget?: boolean;                      // Subject to the pool's retry budget (default: true)
+}
+
+export interface RetryTypeStats {
+  calls: number;
+  retries: number;
+  recovered: number;                     // Calls that succeeded after at least one retry
+  exhausted: number;
+  budgetDenied: number;
+}
+
+export interface AffinityOptions {
+  cpus?: number[];                       // CPU set for workers (default: the process's current CPU set)
+  isolateMainThread?: boolean;           // Reserve the first CPU of the set for the main thread
 }
 
 export interface TaskletStats {
@@ -16,19 +121,170 @@ export interface TaskletStats {
   totalWorkers: number;
   queuedTasks: number;
   idleWorkers: number;
+  recovery: { requeued: number; poisoned: number };
+  circuits: Record<string, CircuitStats>;
+  bulkheads: Record<string, BulkheadStats>;
+  rateLimits: { types: Record<string, RateLimitStats>; tenants: Record<string, RateLimitStats> };
+  resultBatching: ResultBatchingStats;
+  retries: { budget: number; window: { requests: number; retries: number }; types: Record<string, RetryTypeStats> };
   throughput: number;
-  avgTaskTime: number;
+  avgTaskTime: number;                   // Time spent inside the task function, last 10s (ms)
+  avgCpuTime: number | null;             // Worker thread CPU time per task (ms), null if no thread CPU clock
+  taskTimePercentiles: { p50: number; p95: number; p99: number }; // Upper bounds from a log2 histogram (ms)
+  totalTasks: number;
+  processedTasks: number;
+  failedTasks: number;
   config: TaskletsConfig;
 }
 
-export declare class Tasklets {
+export type TaskFunction<T = any> = ((...args: any[]) => T | Promise<T>) | string;
+export type TaskCallback<T = any> = (error: Error | null, result?: T) => void;
+
+export interface TaskOptions<T = any> {
+  task: TaskFunction<T>;
+  args?: any[];
+  name?: string;                         // Task type for per-type policies and stats
+  idempotent?: boolean;                  // Safe to re-run after a worker crash
+  maxAttempts?: number;                  // Crash attempts before an idempotent task is declared poison (default: 3)
+  retry?: number | RetryPolicy;          // Retry failed attempts in the scheduler (number = attempts)
+  tenant?: string;                       // Tenant for per-tenant rate limits
+  rateLimit?: RateLimit;                 // Limit for this task's type, if none is configured yet
+  maxConcurrency?: number;               // Bulkhead for this task's type, if none is configured yet
+  sliced?: boolean;                      // Task calls tasklet.yield() and may share a worker
+}
+
+export interface RetryOptions {
+  args?: any[];
+  name?: string;
+  attempts?: number;                     // Total attempts including the first (default: 3)
+  delay?: number;                        // Base delay in ms (default: 0)
+  backoff?: number;                      // Growth factor for the delay cap, or the schedule with jitter: false (default: 1)
+  maxDelay?: number;
+  jitter?: boolean;                      // default: true
+  differentWorker?: boolean;             // default: true
+}
+
+export interface RunAllOptions {
+  concurrency?: number;                  // Max tasks from this call queued or running at once (default: all)
+  failFast?: boolean;                    // Cancel the rest after the first failure (default: false)
+}
+
+export interface AnyOptions {
+  k?: number;                            // Successful results to wait for (default: 1)
+  concurrency?: number;                  // Max tasks queued or running at once (default: all)
+}
+
+export interface FindResult<T = any> {
+  chunk: number;                         // Index of the chunk that matched
+  index: number;                         // Position of the match inside that chunk
+  value: T;
+}
+
+export interface BspContext<S = any> {
+  step: number;                          // Superstep number, from 0
+  index: number;                         // This partition's index
+  count: number;                         // Number of partitions
+  shared: S;                             // options.shared, as received by this worker
+}
+
+export type BspAggregate = number | ArrayLike<number> | void;
+
+export interface BspOptions<S = any> {
+  maxSteps?: number;                     // Supersteps to run at most (default: 100)
+  until?: (aggregates: any[], step: number) => boolean; // Return true to stop after this step
+  aggregateSize?: number;                // Numbers per partition aggregate (default: 1)
+  shared?: S;                            // Sent with every partition, e.g. SharedArrayBuffers for boundary data
+  collect?: boolean;                     // Return each partition's final state (default: false)
+  startTimeoutMs?: number;               // Fail if not every partition is running by then (default: 10000)
+}
+
+export interface BspResult<P = any> {
+  steps: number;                         // Supersteps run
+  aggregates: number[] | Float64Array[]; // Last step's aggregates: numbers, or Float64Arrays when aggregateSize > 1
+  partitions?: P[];                      // With collect: true
+}
+
+export type BspStep<P = any, S = any> = ((partition: P, ctx: BspContext<S>) => BspAggregate | Promise<BspAggregate>) | string;
+
+export interface MonteCarloOptions {
+  seed?: number;                         // Non-negative safe integer (default: random, returned in the result)
+  chunkSize?: number;                    // Samples per task and per random stream (default: 65536)
+  concurrency?: number;                  // Max chunks queued or running at once (default: all)
+}
+
+export interface MonteCarloResult {
+  samples: number;
+  mean: number;
+  variance: number;                      // Sample variance of fn's values
+  stdError: number;                      // sqrt(variance / samples)
+  seed: number;                          // Seed used, to reproduce the run
+}
+
+export type MonteCarloFn = ((random: () => number, index: number) => number) | string;
+
+export type MatrixData = Float64Array | Float32Array;
+
+export interface Matrix<T extends MatrixData = MatrixData> {
+  rows: number;
+  cols: number;
+  data: T;                               // Row-major, rows x cols elements
+}
+
+export interface ScanOptions {
+  chunkSize?: number;                    // Bytes per chunk (default: 8 MiB)
+  overlap?: number;                      // Scan this far past each chunk instead of aligning to lines
+  encoding?: 'latin1' | 'utf8';          // How bytes are decoded for matching (default: 'latin1')
+  concurrency?: number;                  // Chunks in flight or awaiting consumption (default: 2 x maxWorkers)
+}
+
+export interface ScanMatch {
+  offset: number;                        // Byte offset in the input
+  match: string;
+}
+
+export interface BatchOptions extends RunAllOptions {
+  onProgress?: (progress: { completed: number; total: number; percentage: number }) => void;
+  journal?: string;                      // Path of a checkpoint journal (enables resumeBatch)
+  syncEvery?: number;                    // Journal records between fdatasync calls (default: 1000)
+}
+
+export interface BatchResult<T = any> {
+  name: string;
+  result?: T;
+  error?: string;
+  success: boolean;
+  cancelled?: boolean;                   // Skipped by failFast; not journaled
+  aborted?: boolean;                     // Dropped by terminate() or a timed-out drain; not journaled
+}
+
+export interface DrainSummary {
+  pending: number;                       // In-flight + queued tasks when drain() was called
+  completed: number;
+  failed: number;
+  abandoned: number;                     // Tasks rejected because timeoutMs elapsed
+  timedOut: boolean;
+  durationMs: number;
+}
+
+export declare class Tasklets extends EventEmitter {
   constructor(config?: TaskletsConfig);
 
   // Instance Methods
-  run<T = any>(task: ((...args: any[]) => T | Promise<T>) | string, ...args: any[]): Promise<T>;
-  runAll<T = any>(tasks: Array<((...args: any[]) => T | Promise<T>) | { task: any; args?: any[] }>): Promise<Array<T>>;
-  batch<T = any>(tasks: Array<((...args: any[]) => T | Promise<T>) | { task: any; args?: any[]; name?: string }>, options?: { onProgress?: (progress: { completed: number; total: number; percentage: number }) => void }): Promise<Array<{ name: string; result?: T; error?: string; success: boolean }>>;
-  retry<T = any>(task: ((...args: any[]) => T | Promise<T>) | string, options?: { attempts?: number; delay?: number; backoff?: number }): Promise<T>;
+  run<T = any>(task: TaskFunction<T>, ...args: any[]): Promise<T>;
+  run<T = any>(task: TaskOptions<T>): Promise<T>;
+  /** Promise-free submission; args are not validated and must be structured-cloneable. */
+  submit<T = any>(task: TaskFunction<T> | TaskOptions<T>, args: any[] | undefined, callback: TaskCallback<T>): void;
+  runAll<T = any>(tasks: Array<((...args: any[]) => T | Promise<T>) | { task: any; args?: any[] }>, options?: RunAllOptions): Promise<Array<T>>;
+  any<T = any>(tasks: Array<((...args: any[]) => T | Promise<T>) | { task: any; args?: any[] }>, options?: AnyOptions): Promise<Array<T>>;
+  find<T = any>(chunks: Array<ArrayLike<T>>, predicate: ((item: T, index: number) => boolean) | string, options?: { concurrency?: number }): Promise<FindResult<T> | undefined>;
+  scan(input: Uint8Array | string, pattern: RegExp | string, options?: ScanOptions): AsyncGenerator<ScanMatch, void, undefined>;
+  monteCarlo(samples: number, fn: MonteCarloFn, options?: MonteCarloOptions): Promise<MonteCarloResult>;
+  bsp<P = any, S = any>(partitions: P[], step: BspStep<P, S>, options?: BspOptions<S>): Promise<BspResult<P>>;
+  matmul<T extends MatrixData>(A: Matrix<T>, B: Matrix<T>): Promise<Matrix<T>>;
+  batch<T = any>(tasks: Array<((...args: any[]) => T | Promise<T>) | { task: any; args?: any[]; name?: string }>, options?: BatchOptions): Promise<Array<BatchResult<T>>>;
+  resumeBatch<T = any>(journalPath: string, options?: BatchOptions): Promise<Array<BatchResult<T>>>;
+  retry<T = any>(task: TaskFunction<T> | TaskOptions<T>, options?: RetryOptions): Promise<T>;
+  reloadModule(modulePath: string, options?: { mode?: 'roll' | 'invalidate' }): Promise<{ mode: 'roll' | 'invalidate'; workers: number }>;
 
   configure(config: TaskletsConfig): this;
   enableAdaptiveMode(): this;
@@ -37,19 +293,33 @@ export declare class Tasklets {
   getStats(): TaskletStats;
   getHealth(): { status: string; workers: number; memoryUsagePercent: number };
 
+  drain(options?: { timeoutMs?: number }): Promise<DrainSummary>;
+  resume(): this;
   terminate(): Promise<void>;
   shutdown(): Promise<void>;
 
   // Static Methods (Singleton Proxy)
-  static run<T = any>(task: ((...args: any[]) => T | Promise<T>) | string, ...args: any[]): Promise<T>;
-  static runAll<T = any>(tasks: Array<any>): Promise<Array<T>>;
+  static run<T = any>(task: TaskFunction<T>, ...args: any[]): Promise<T>;
+  static run<T = any>(task: TaskOptions<T>): Promise<T>;
+  static submit<T = any>(task: TaskFunction<T> | TaskOptions<T>, args: any[] | undefined, callback: TaskCallback<T>): void;
+  static runAll<T = any>(tasks: Array<any>, options?: RunAllOptions): Promise<Array<T>>;
+  static any<T = any>(tasks: Array<any>, options?: AnyOptions): Promise<Array<T>>;
+  static find<T = any>(chunks: Array<ArrayLike<T>>, predicate: ((item: T, index: number) => boolean) | string, options?: { concurrency?: number }): Promise<FindResult<T> | undefined>;
+  static scan(input: Uint8Array | string, pattern: RegExp | string, options?: ScanOptions): AsyncGenerator<ScanMatch, void, undefined>;
+  static monteCarlo(samples: number, fn: MonteCarloFn, options?: MonteCarloOptions): Promise<MonteCarloResult>;
+  static bsp<P = any, S = any>(partitions: P[], step: BspStep<P, S>, options?: BspOptions<S>): Promise<BspResult<P>>;
+  static matmul<T extends MatrixData>(A: Matrix<T>, B: Matrix<T>): Promise<Matrix<T>>;
   static batch<T = any>(tasks: Array<any>, options?: any): Promise<Array<T>>;
+  static resumeBatch<T = any>(journalPath: string, options?: BatchOptions): Promise<Array<BatchResult<T>>>;
   static retry<T = any>(task: any, options?: any): Promise<T>;
+  static reloadModule(modulePath: string, options?: { mode?: 'roll' | 'invalidate' }): Promise<{ mode: 'roll' | 'invalidate'; workers: number }>;
   static configure(config: TaskletsConfig): void;
   static enableAdaptiveMode(): void;
   static setWorkloadType(type: 'cpu' | 'io' | 'mixed'): void;
   static getStats(): TaskletStats;
   static getHealth(): any;
+  static drain(options?: { timeoutMs?: number }): Promise<DrainSummary>;
+  static resume(): void;
   static terminate(): Promise<void>;
   static shutdown(): Promise<void>;
 }
@@ -6,13 +6,64 @@
  * @brief Main Tasklets entry point - Native JS implementation
  */
 
-const { Worker } = require('worker_threads');
+const { Worker, MessageChannel } = require('worker_threads');
 const path = require('path');
+const fs = require('fs');
 const os = require('os');
 const crypto = require('crypto');
 const EventEmitter = require('events');
 const MetricsManager = require('./metrics');
 const AdaptiveManager = require('./adaptive');
+const BatchJournal = require('./journal');
+const AffinityManager = require('./affinity');
+const RetryManager = require('./retry');
+const CircuitManager = require('./circuit');
+const RateLimitManager = require('./ratelimit');
+const BulkheadManager = require('./bulkhead');
+const clock = require('./clock');
+const TaskSlots = require('./slots');
+
+const TASK_RECORD_POOL_SIZE = 1024;
+const NO_ARGS = Object.freeze([]);
+
+// bsp() control words, shared with lib/builtins/bsp.js
+const BSP_RELEASED = 0;
+const BSP_ARRIVED = 1;
+const BSP_STOP = 2;
+const BSP_STARTED = 3;
+
+// One shape for every task record, so recycled and fresh records share a
+// hidden class. See run() for the meaning of each field.
+function createTaskRecord() {
+    return {
+        id: 0,
+        task: null,
+        args: null,
+        resolve: null,
+        reject: null,
+        promise: null,
+        callback: null,
+        group: null,
+        startTime: 0,
+        worker: null,
+        type: null,
+        idempotent: false,
+        maxAttempts: 3,
+        crashes: 0,
+        retry: null,
+        attempts: 0,
+        notBefore: 0,
+        avoidWorker: null,
+        lastDelay: 0,
+        probe: false,
+        evicted: false,
+        tenant: undefined,
+        rateHeld: false,
+        bulkhead: null,
+        bulkheadHeld: false,
+        sliced: false
+    };
+}
 
 class Tasklets extends EventEmitter {
     constructor(config = {}) {
@@ -25,19 +76,49 @@ class Tasklets extends EventEmitter {
         this.maxMemory = config.maxMemory || 0; // 0 = no limit, value in % of total system memory
         this.allowedModules = config.allowedModules || null; // Optional allowlist
 
-        this.workerPool = []; // { worker, busy, lastUsed }
-        this.activeTasks = new Map();
+        this.workerPool = []; // { worker, port, busy, running, exclusive, lastUsed, cpu, tid, cancelFlag, timedOut }
+        this.timeSlicing = null; // { maxConcurrentPerWorker, quantumMs } when enabled
+        if (config.timeSlicing) this._configureTimeSlicing(config.timeSlicing);
+        this.resultBatching = null; // { maxBatch } when results are delivered in batches
+        this.completions = []; // Finished tasks awaiting delivery: task, error, result, ...
+        this.completionTimer = null;
+        this.flushCompletions = () => this._flushCompletions();
+        this.batchStats = { batches: 0, delivered: 0, largestBatch: 0 };
+        if (config.resultBatching) this._configureResultBatching(config.resultBatching);
+        this.activeTasks = new TaskSlots(); // In-flight tasks by generation-tagged task ID
+        this.taskRecords = []; // Recycled task records
+        this.taskSources = new WeakMap(); // Task function -> source string
+        this.outgoing = { taskId: 0, task: null, args: null }; // Reused: postMessage clones synchronously
         this.taskQueue = [];
+        this.parked = new Map(); // Full bulkhead or empty token bucket -> { manager, tasks } held by it
+        this.parkedCount = 0;
         this.workerScript = path.join(__dirname, 'worker.js');
-        this.nextTaskId = 1;
         this.isTerminated = false;
+        this.isDraining = false;
+        this.drainState = null;
+        this.openGroups = new Set(); // Batches admitted before a drain that still hold unsubmitted tasks
+        this.wakeTimer = null; // Fires when the earliest held (backoff, rate limit) task becomes eligible
+        this.wakeAt = 0;
+
+        // Crash recovery bookkeeping (idempotent tasks re-queued after a worker crash)
+        this.recoveryStats = { requeued: 0, poisoned: 0 };
 
-        // Generate a secret token for worker authentication
+        // Generate a secret token for the worker handshake
         this.workerSecret = this._generateSecret();
 
         // Modular Managers
         this.metricsManager = new MetricsManager();
         this.adaptiveManager = new AdaptiveManager(this);
+        this.affinityManager = new AffinityManager(this);
+        if (config.affinity) this.affinityManager.configure(config.affinity);
+        this.retryManager = new RetryManager(this);
+        if (config.retry) this.retryManager.configure(config.retry);
+        this.circuitManager = new CircuitManager(this);
+        if (config.circuitBreaker) this.circuitManager.configure(config.circuitBreaker);
+        this.rateLimitManager = new RateLimitManager(this);
+        if (config.rateLimit) this.rateLimitManager.configure(config.rateLimit, clock.now());
+        this.bulkheadManager = new BulkheadManager(this);
+        if (config.bulkheads) this.bulkheadManager.configure(config.bulkheads);
 
         // Maintenance loop
         this.maintenanceInterval = setInterval(() => this._maintenance(), 2000);
@@ -83,18 +164,36 @@ class Tasklets extends EventEmitter {
 
         // 2. Timeout: Reject tasks that exceeded globalTimeout
         if (this.globalTimeout > 0) {
-            for (const [taskId, task] of this.activeTasks.entries()) {
-                const elapsed = now - task.startTime;
+            // Sliced tasks asked to stop at the previous pass that are still running
+            for (const w of this.workerPool.filter(w => w.timedOut && w.timedOut.size > 0)) {
+                this._log('warn', `Worker ignored the cancellation of ${w.timedOut.size} timed-out task(s), terminating it`);
+                this._evictWorker(w);
+            }
+
+            const clockNow = clock.now();
+            this.activeTasks.forEach((task, taskId) => {
+                const elapsed = clockNow - task.startTime;
                 if (elapsed > this.globalTimeout) {
                     const workerObj = this.workerPool.find(w => w.worker === task.worker);
                     if (workerObj) {
                         this._log('warn', `Task ${taskId} timed out after ${elapsed}ms (limit: ${this.globalTimeout}ms)`);
-                        task.reject(new Error(`Task timed out after ${this.globalTimeout}ms`));
-                        this.activeTasks.delete(taskId);
-                        this._terminateWorker(workerObj);
+                        if (this.circuitManager.enabled) this.circuitManager.record(task, false);
+                        this._settle(task, new Error(`Task timed out after ${this.globalTimeout}ms`));
+                        this.activeTasks.release(taskId);
+                        if (task.bulkhead) this.bulkheadManager.release(task);
+                        if (this._tasksOn(workerObj.worker) > 0) {
+                            // Time-sliced neighbours are fine: ask only this task to
+                            // stop, and terminate the worker if it doesn't
+                            if (!workerObj.timedOut) workerObj.timedOut = new Set();
+                            workerObj.timedOut.add(taskId);
+                            Atomics.store(workerObj.cancelFlag, 0, taskId);
+                            workerObj.port.postMessage({ type: 'cancel', taskId });
+                        } else {
+                            this._terminateWorker(workerObj);
+                        }
                     }
                 }
-            }
+            });
         }
 
         // 3. Adaptive Heuristics (Externalized)
@@ -105,6 +204,34 @@ class Tasklets extends EventEmitter {
         }
     }
 
+    _tasksOn(worker) {
+        let count = 0;
+        this.activeTasks.forEach((task) => {
+            if (task.worker === worker) count++;
+        });
+        return count;
+    }
+
+    /**
+     * Terminates a worker whose timed-out task ignored cancellation. The
+     * tasks sharing it did nothing wrong: they go back to the front of the
+     * queue and are not charged another attempt.
+     */
+    _evictWorker(workerObj) {
+        const evicted = [];
+        this.activeTasks.forEach((task, taskId) => {
+            if (task.worker !== workerObj.worker) return;
+            this.activeTasks.release(taskId);
+            if (task.bulkhead) this.bulkheadManager.release(task);
+            task.worker = null;
+            task.evicted = true;
+            evicted.push(task);
+        });
+        this.recoveryStats.requeued += evicted.length;
+        this.taskQueue.unshift(...evicted);
+        this._terminateWorker(workerObj);
+    }
+
     _terminateWorker(workerObj) {
         // First reject any pending tasks on this worker
         this._cleanupWorkerTasks(workerObj.worker, 'Worker was terminated by Tasklets');
@@ -113,65 +240,173 @@ class Tasklets extends EventEmitter {
         workerObj.worker.terminate().catch(() => { });
     }
 
-    _getWorker() {
+    _getWorker(task) {
         // Apply adaptive limits (Effective Max)
         const effectiveMax = this.adaptiveManager.getEffectiveMax();
 
-        // 1. Try to find an idle worker
-        const idleWorker = this.workerPool.find(w => !w.busy);
-        if (idleWorker) {
-            return idleWorker;
+        // 1. Try to find an idle worker. A retrying task prefers any worker
+        //    other than the one it just failed on, and falls back to that one
+        //    only when nothing else is idle and the pool cannot grow.
+        const avoid = task ? task.avoidWorker : null;
+        let fallback = null;
+        for (const w of this.workerPool) {
+            if (w.busy) continue;
+            if (w.worker !== avoid) return w;
+            fallback = w;
+        }
+        if (fallback && this.workerPool.length >= effectiveMax) {
+            return fallback;
+        }
+
+        // 2. With time slicing, a worker running only sliced tasks can take
+        //    one more task; its tasks yield to each other round-robin.
+        if (this.timeSlicing && this.workerPool.length >= effectiveMax) {
+            const shared = this._getSharedWorker();
+            if (shared) return shared;
         }
 
-        // 2. Check maxMemory before spawning new workers
+        // 3. Check maxMemory before spawning new workers
         if (this.maxMemory > 0) {
-            const totalMem = os.totalmem();
-            const usedMem = totalMem - os.freemem();
-            const usedPercent = (usedMem / totalMem) * 100;
+            const usedPercent = this._memoryUsedPercent();
             if (usedPercent > this.maxMemory) {
                 this._log('warn', `Memory limit reached (${usedPercent.toFixed(1)}% / ${this.maxMemory}%). Not spawning new worker.`);
-                return null;
+                return fallback;
             }
         }
 
-        // 3. If no idle worker, check if we can spawn more
+        // 4. If no idle worker, check if we can spawn more
         if (this.workerPool.length < effectiveMax) {
             this._log('debug', `Spawning worker ${this.workerPool.length + 1}/${effectiveMax}`);
-            const worker = new Worker(this.workerScript, {
-                workerData: {
-                    secret: this.workerSecret,
-                    allowedModules: this.allowedModules
-                }
-            });
-            this._initWorker(worker);
-            const workerObj = { worker, busy: false, lastUsed: Date.now() };
-            this.workerPool.push(workerObj);
-            return workerObj;
+            return this._spawnWorker();
         }
 
-        return null;
+        return fallback || (this.timeSlicing ? this._getSharedWorker() : null);
     }
 
-    _initWorker(worker) {
+    _memoryUsedPercent() {
+        const totalMem = os.totalmem();
+        return ((totalMem - os.freemem()) / totalMem) * 100;
+    }
+
+    /**
+     * Workers that tasks could run on at once: the live pool plus what may
+     * still be spawned under the adaptive limit and maxMemory.
+     */
+    _workerCapacity() {
+        let live = 0;
+        for (const w of this.workerPool) if (!w.retiring) live++;
+        const memoryFull = this.maxMemory > 0 && this._memoryUsedPercent() > this.maxMemory;
+        const spawnable = memoryFull ? 0 : this.adaptiveManager.getEffectiveMax() - this.workerPool.length;
+        return live + Math.max(0, spawnable);
+    }
+
+    /**
+     * Starts a worker and adds it to the pool, regardless of limits.
+     */
+    _spawnWorker() {
+        const cpu = this.affinityManager.assignCpu();
+        const metricsSlot = this.metricsManager.acquireWorkerSlot();
+        const { port1, port2 } = new MessageChannel();
+        // ID of a running task asked to stop, readable by the task without
+        // yielding to the worker's event loop (see tasklet.cancelled)
+        const cancelFlag = new Int32Array(new SharedArrayBuffer(4));
+        cancelFlag[0] = -1;
+        const worker = new Worker(this.workerScript, {
+            workerData: {
+                secret: this.workerSecret,
+                allowedModules: this.allowedModules,
+                cpu,
+                // Fallback mask if pinning to `cpu` fails: without it the worker
+                // would keep the mask inherited from an isolated main thread
+                cpus: cpu !== undefined ? this.affinityManager.cpus : undefined,
+                metrics: metricsSlot,
+                quantumMs: this.timeSlicing ? this.timeSlicing.quantumMs : undefined,
+                cancelFlag: cancelFlag.buffer
+            }
+        });
+        // Handshake: prove knowledge of the secret once and hand over the
+        // private port that carries all task traffic for this worker.
+        worker.postMessage({ type: 'handshake', secret: this.workerSecret, port: port2 }, [port2]);
+        worker.once('exit', () => {
+            this.metricsManager.releaseWorkerSlot(metricsSlot);
+            port1.close();
+        });
+        const workerObj = { worker, port: port1, busy: false, running: 0, exclusive: false, lastUsed: Date.now(), cpu, tid: null, cancelFlag, timedOut: null };
+        this._initWorker(workerObj);
+        this.workerPool.push(workerObj);
+        return workerObj;
+    }
+
+    /**
+     * Least-loaded worker that only runs sliced tasks and has room for one more.
+     */
+    _getSharedWorker() {
+        let best = null;
+        for (const w of this.workerPool) {
+            if (w.exclusive || w.retiring || w.running >= this.timeSlicing.maxConcurrentPerWorker) continue;
+            if (!best || w.running < best.running) best = w;
+        }
+        return best;
+    }
+
+    _configureTimeSlicing(options) {
+        if (!options) {
+            this.timeSlicing = null;
+            return;
+        }
+        const opts = options === true ? {} : options;
+        this.timeSlicing = {
+            maxConcurrentPerWorker: opts.maxConcurrentPerWorker || 4,
+            quantumMs: opts.quantumMs || 10
+        };
+        for (const w of this.workerPool) {
+            w.port.postMessage({ type: 'timeSlicing', quantumMs: this.timeSlicing.quantumMs });
+        }
+    }
+
+    _initWorker(workerObj) {
+        const { worker, port } = workerObj;
         worker.on('message', (msg) => {
+            if (msg.type === 'affinity') this._onWorkerAffinity(worker, msg);
+        });
+
+        port.on('message', (msg) => {
             const task = this.activeTasks.get(msg.taskId);
-            if (task) {
-                if (msg.error) {
-                    task.reject(new Error(msg.error));
-                } else {
-                    task.resolve(msg.result);
-                }
+            // Only the worker a task was dispatched to may settle it
+            if (task && task.worker === worker) {
+                this.activeTasks.release(msg.taskId);
+                if (task.bulkhead) this.bulkheadManager.release(task);
+                if (this.circuitManager.enabled) this.circuitManager.record(task, !msg.error);
 
-                // Update metrics manager
-                const duration = Date.now() - task.startTime;
-                this.metricsManager.recordTaskEnd(duration);
+                let settled = true;
+                if (!msg.error) {
+                    if (task.retry) this.retryManager.recordSuccess(task);
+                } else if (task.retry && !(task.group && task.group.stopped) && this._scheduleRetry(task, msg.error)) {
+                    settled = false;
+                }
 
-                this.activeTasks.delete(msg.taskId);
+                // Still in the pool (not terminated or crashed meanwhile)
+                const inPool = this.workerPool.includes(workerObj);
+                if (inPool) this._releaseWorker(workerObj, task.sliced);
 
-                const workerObj = this.workerPool.find(w => w.worker === worker);
-                if (workerObj) {
-                    workerObj.busy = false;
-                    workerObj.lastUsed = Date.now();
+                // Settle before refilling the worker, so a callback can still
+                // cancel queued work (failFast). A submit() callback runs
+                // synchronously and may throw; the queue is processed anyway.
+                try {
+                    if (settled && this.resultBatching) {
+                        this._deferCompletion(task, msg.error || null, msg.result);
+                    } else if (settled) {
+                        this._settle(task, msg.error ? new Error(msg.error) : null, msg.result);
+                        this._recycleTask(task);
+                    }
+                } finally {
+                    if (inPool) this._processQueue();
+                    if (this.drainState) this._checkDrained();
+                }
+            } else if (workerObj.timedOut && workerObj.timedOut.delete(msg.taskId)) {
+                // A timed-out sliced task that stopped when cancelled
+                if (this.workerPool.includes(workerObj)) {
+                    this._releaseWorker(workerObj, true);
                     this._processQueue();
                 }
             }
@@ -179,24 +414,145 @@ class Tasklets extends EventEmitter {
 
         worker.on('error', (err) => {
             this._log('error', 'Worker Error:', err);
-            this._cleanupWorkerTasks(worker, `Worker error: ${err.message}`);
+            this._cleanupWorkerTasks(worker, `Worker error: ${err.message}`, true);
         });
 
         worker.on('exit', (code) => {
             if (code !== 0 && !this.isTerminated) {
-                this._log('error', `Worker exited with code ${code}`);
-                this._cleanupWorkerTasks(worker, `Worker exited unexpectedly with code ${code}`);
+                // Workers we terminate ourselves have already left the pool
+                const crashed = this.workerPool.some(w => w.worker === worker);
+                if (crashed) this._log('error', `Worker exited with code ${code}`);
+                this._cleanupWorkerTasks(worker, `Worker exited unexpectedly with code ${code}`, crashed);
             }
         });
     }
 
-    _cleanupWorkerTasks(worker, errorMessage) {
-        // 1. Reject and delete all tasks assigned to this worker (regardless of pool status)
-        for (const [taskId, task] of this.activeTasks.entries()) {
+    _releaseWorker(workerObj, sliced) {
+        workerObj.running--;
+        if (!sliced) workerObj.exclusive = false;
+        // A time-sliced worker may still be running other tasks
+        if (workerObj.running === 0) {
+            if (workerObj.retiring) {
+                this._retireWorker(workerObj);
+            } else {
+                workerObj.busy = false;
+                workerObj.lastUsed = Date.now();
+            }
+        }
+    }
+
+    /**
+     * Result batching. The scheduling side of a completion (slot, worker,
+     * queue) is handled as each message arrives, so workers pick up new
+     * work right away; only settlement is deferred. Node runs microtasks
+     * after every message event, so completions can only be combined across
+     * events by waiting for the check phase: one setImmediate() then settles
+     * everything that arrived during the loop iteration, after pending I/O
+     * callbacks have had their turn.
+     */
+    _configureResultBatching(options) {
+        if (!options) {
+            this.resultBatching = null;
+            this._flushCompletions();
+            return;
+        }
+        const opts = options === true ? {} : options;
+        const maxBatch = opts.maxBatch !== undefined ? opts.maxBatch : 256;
+        if (!Number.isInteger(maxBatch) || maxBatch < 1) {
+            throw new Error('resultBatching maxBatch must be a positive integer');
+        }
+        this.resultBatching = { maxBatch };
+    }
+
+    _deferCompletion(task, error, result) {
+        const completions = this.completions;
+        completions.push(task, error, result);
+        // A full batch is delivered right away to bound latency and memory
+        if (completions.length >= this.resultBatching.maxBatch * 3) {
+            this._flushCompletions();
+        } else if (this.completionTimer === null) {
+            this.completionTimer = setImmediate(this.flushCompletions);
+        }
+    }
+
+    _flushCompletions() {
+        if (this.completionTimer !== null) {
+            clearImmediate(this.completionTimer);
+            this.completionTimer = null;
+        }
+        const completions = this.completions;
+        if (completions.length === 0) return;
+
+        let i = 0;
+        try {
+            for (; i < completions.length; i += 3) {
+                const task = completions[i];
+                const error = completions[i + 1];
+                this._settle(task, error === null ? null : new Error(error), completions[i + 2]);
+                this._recycleTask(task);
+            }
+        } finally {
+            // A throwing callback surfaces as usual; the rest of the batch
+            // is delivered on the next turn
+            const delivered = Math.min(i + 3, completions.length) / 3;
+            const stats = this.batchStats;
+            stats.batches++;
+            stats.delivered += delivered;
+            if (delivered > stats.largestBatch) stats.largestBatch = delivered;
+            if (i + 3 < completions.length) {
+                completions.splice(0, i + 3);
+                this.completionTimer = setImmediate(this.flushCompletions);
+            } else {
+                completions.length = 0;
+                if (this.drainState) this._checkDrained();
+            }
+        }
+    }
+
+    _onWorkerAffinity(worker, msg) {
+        const workerObj = this.workerPool.find(w => w.worker === worker);
+        if (msg.error) {
+            this._log('warn', `Failed to pin worker to CPU ${msg.cpu}: ${msg.error}`);
+            if (workerObj) workerObj.cpu = undefined;
+            return;
+        }
+        this._log('debug', `Worker thread ${msg.tid} pinned to CPU ${msg.cpu}`);
+        if (workerObj) workerObj.tid = msg.tid;
+    }
+
+    _cleanupWorkerTasks(worker, errorMessage, crashed = false) {
+        // 1. Reject and delete all tasks assigned to this worker (regardless of pool status).
+        //    After a crash, idempotent tasks go back to the front of the queue instead.
+        const requeue = [];
+        this.activeTasks.forEach((task, taskId) => {
             if (task.worker === worker) {
-                task.reject(new Error(errorMessage));
-                this.activeTasks.delete(taskId);
+                this.activeTasks.release(taskId);
+                if (task.bulkhead) this.bulkheadManager.release(task);
+                if (crashed && this.circuitManager.enabled) this.circuitManager.record(task, false);
+                if (crashed && task.idempotent) {
+                    task.crashes++;
+                    if (task.crashes < task.maxAttempts) {
+                        requeue.push(task);
+                        return;
+                    }
+                    // Poison task: it keeps taking workers down with it, stop retrying.
+                    this.recoveryStats.poisoned++;
+                    this._log('error', `Task ${task.type} crashed ${task.crashes} workers, giving up`);
+                    this.emit('task:poisoned', { type: task.type, crashes: task.crashes });
+                    this._settle(task, new Error(`Poison task: ${task.type} crashed ${task.crashes} workers (${errorMessage})`));
+                    return;
+                }
+                this._settle(task, new Error(errorMessage));
             }
+        });
+
+        for (let i = requeue.length - 1; i >= 0; i--) {
+            const task = requeue[i];
+            this.recoveryStats.requeued++;
+            this._log('warn', `Re-queuing idempotent task ${task.type} after worker crash (attempt ${task.crashes + 1}/${task.maxAttempts})`);
+            this.emit('task:requeued', { type: task.type, attempt: task.crashes + 1 });
+            task.worker = null;
+            this.taskQueue.unshift(task);
         }
 
         // 2. Remove the worker from the pool if it's still there
@@ -205,97 +561,1041 @@ class Tasklets extends EventEmitter {
             this.workerPool.splice(idx, 1);
         }
 
-        // 3. Process queue with remaining workers
+        // 3. Replace a crashed worker right away so warm capacity is not lost
+        if (crashed && !this.isTerminated && this.workerPool.length < this.minWorkers) {
+            this._getWorker();
+        }
+
+        // 4. Process queue with remaining workers
         this._processQueue();
+
+        if (this.drainState) this._checkDrained();
+    }
+
+    /**
+     * Removes a worker that finished its last task after being marked for
+     * retirement (pool shrink, module reload). It never goes back to idle.
+     */
+    _retireWorker(workerObj) {
+        const idx = this.workerPool.indexOf(workerObj);
+        if (idx !== -1) this.workerPool.splice(idx, 1);
+        this._log('debug', 'Retired surplus worker after its last task');
+        workerObj.worker.terminate().catch(() => { });
+    }
+
+    /**
+     * Applies a lowered maxWorkers without dropping work: idle surplus
+     * workers exit now, busy ones retire when their current task finishes.
+     */
+    _resizePool() {
+        let surplus = this.workerPool.filter(w => !w.retiring).length - this.adaptiveManager.getEffectiveMax();
+        if (surplus <= 0) {
+            // Grown (or unchanged): let queued work use the new capacity.
+            this._processQueue();
+            return;
+        }
+
+        for (const w of this.workerPool.filter(w => !w.busy)) {
+            if (surplus === 0) break;
+            this._terminateWorker(w);
+            surplus--;
+        }
+        for (const w of this.workerPool) {
+            if (surplus === 0) break;
+            if (w.busy && !w.retiring) {
+                w.retiring = true;
+                surplus--;
+            }
+        }
     }
 
     _processQueue() {
-        if (this.taskQueue.length === 0) return;
+        while (this.taskQueue.length > 0 || this.parkedCount > 0) {
+            const index = this._nextEligible();
+            if (index === -1) return;
+            const task = this.taskQueue[index];
 
-        // Try to get a worker (idle or new)
-        const workerObj = this._getWorker();
+            // Tasks of a type whose circuit opened while they waited fail here
+            if (this.circuitManager.enabled && !this.circuitManager.canDispatch(task)) {
+                this.taskQueue.splice(index, 1);
+                this._settle(task, this.circuitManager.rejectionError(task));
+                continue;
+            }
 
-        if (workerObj) {
-            this.metricsManager.recordTaskStart();
-            const { taskFn, resolve, reject, args, startTime } = this.taskQueue.shift();
-            const taskId = this.nextTaskId++;
-
-            this.activeTasks.set(taskId, { resolve, reject, startTime, worker: workerObj.worker });
-            workerObj.busy = true;
-
-            workerObj.worker.postMessage({
-                taskId,
-                task: taskFn.toString(),
-                args,
-                secret: this.workerSecret
-            });
+            // Try to get a worker (idle or new)
+            const workerObj = this._getWorker(task);
+            if (!workerObj) return;
+            if (index === 0) this.taskQueue.shift();
+            else this.taskQueue.splice(index, 1);
+            this._dispatch(workerObj, task);
         }
     }
 
+    /**
+     * Index of the first queued task allowed to start now, or -1. Tasks held
+     * by a full bulkhead or an empty token bucket are parked on it, out of
+     * the queue, so later scans don't walk over them again; tasks in a retry
+     * backoff are skipped over. A timer is armed for the earliest timed hold.
+     * Bulkheads need no timer: a finishing task calls _processQueue() again.
+     */
+    _nextEligible() {
+        const now = clock.now();
+        let wakeAt = this.parkedCount > 0 ? this._unpark(now) : Infinity;
+        const queue = this.taskQueue;
+        const limiter = this.rateLimitManager.enabled ? this.rateLimitManager : null;
+        const bulkheads = this.bulkheadManager.enabled ? this.bulkheadManager : null;
+        if (queue.length > 0 && !limiter && !bulkheads && !queue[0].notBefore) return 0;
+
+        let found = -1;
+        let kept = 0;
+        let i = 0;
+        while (i < queue.length && found === -1) {
+            const t = queue[i++];
+            let holder = bulkheads ? bulkheads.heldBy(t) : null;
+            if (holder) {
+                this._park(holder, bulkheads, t);
+                continue;
+            }
+            if (t.notBefore > now) {
+                if (t.notBefore < wakeAt) wakeAt = t.notBefore;
+            } else if ((holder = limiter ? limiter.heldBy(t, now) : null)) {
+                this._park(holder, limiter, t);
+                wakeAt = Math.min(wakeAt, now + limiter.wakeIn(holder, now));
+                continue;
+            } else {
+                found = kept;
+            }
+            queue[kept++] = t;
+        }
+        if (kept < i) {
+            queue.copyWithin(kept, i);
+            queue.length -= i - kept;
+        }
+        this._scheduleWake(wakeAt);
+        return found;
+    }
+
+    _park(holder, manager, task) {
+        let entry = this.parked.get(holder);
+        if (!entry) {
+            entry = { manager, tasks: [] };
+            this.parked.set(holder, entry);
+        }
+        entry.tasks.push(task);
+        this.parkedCount++;
+    }
+
+    /**
+     * Moves parked tasks back to the front of the queue, as many per holder
+     * as it has room for now. Returns when the next timed holder frees up.
+     */
+    _unpark(now) {
+        let released = null;
+        let wakeAt = Infinity;
+        for (const [holder, entry] of this.parked) {
+            const room = entry.manager.room(holder, now);
+            if (room >= entry.tasks.length) {
+                released = released ? released.concat(entry.tasks) : entry.tasks;
+                this.parkedCount -= entry.tasks.length;
+                this.parked.delete(holder);
+            } else {
+                if (room > 0) {
+                    released = released ? released.concat(entry.tasks.splice(0, room)) : entry.tasks.splice(0, room);
+                    this.parkedCount -= room;
+                }
+                wakeAt = Math.min(wakeAt, now + entry.manager.wakeIn(holder, now));
+            }
+        }
+        if (released) this.taskQueue = released.concat(this.taskQueue);
+        return wakeAt;
+    }
+
+    /**
+     * Removes and returns every parked task matching `predicate`.
+     */
+    _takeParked(predicate) {
+        const taken = [];
+        for (const [holder, entry] of this.parked) {
+            const kept = entry.tasks.filter(task => !predicate(task) || !taken.push(task));
+            if (kept.length === 0) this.parked.delete(holder);
+            else entry.tasks = kept;
+        }
+        this.parkedCount -= taken.length;
+        return taken;
+    }
+
+    /**
+     * Arms a single timer for the earliest time a held task becomes eligible.
+     */
+    _scheduleWake(at) {
+        if (at === Infinity || (this.wakeTimer && this.wakeAt <= at)) return;
+
+        clearTimeout(this.wakeTimer);
+        this.wakeAt = at;
+        this.wakeTimer = setTimeout(() => {
+            this.wakeTimer = null;
+            this._processQueue();
+        }, Math.max(0, at - clock.now()));
+    }
+
+    /**
+     * Puts a failed task back in the queue after a jittered backoff, reusing
+     * the already serialized task and args. Returns false when the retry
+     * policy is exhausted or the pool's retry budget is spent.
+     */
+    _scheduleRetry(task, error) {
+        if (this.isTerminated) return false;
+        if (this.circuitManager.enabled && !this.circuitManager.isClosed(task.type)) return false;
+        const delay = this.retryManager.nextDelay(task);
+        if (delay < 0) return false;
+
+        this._log('debug', `Retrying ${task.type} in ${Math.round(delay)}ms (attempt ${task.attempts + 1}/${task.retry.attempts}): ${error}`);
+        this.emit('task:retry', { type: task.type, attempt: task.attempts + 1, delay, error });
+
+        task.avoidWorker = task.retry.differentWorker ? task.worker : null;
+        task.worker = null;
+        task.notBefore = clock.now() + delay;
+        this.taskQueue.push(task);
+        this._scheduleWake(task.notBefore);
+        return true;
+    }
+
+    _dispatch(workerObj, task) {
+        if (task.evicted) {
+            task.evicted = false; // Requeued by _evictWorker: still the same attempt
+        } else {
+            if (task.attempts === 0) {
+                this.metricsManager.recordTaskStart();
+                this.retryManager.recordRequest();
+                if (task.retry) this.retryManager.recordCall(task);
+            }
+            task.attempts++;
+        }
+        task.notBefore = 0;
+        if (this.rateLimitManager.enabled) this.rateLimitManager.take(task);
+        if (this.bulkheadManager.enabled) this.bulkheadManager.acquire(task);
+
+        task.worker = workerObj.worker;
+        task.id = this.activeTasks.acquire(task);
+        workerObj.busy = true;
+        workerObj.running++;
+        if (!task.sliced) workerObj.exclusive = true;
+
+        const msg = this.outgoing;
+        msg.taskId = task.id;
+        msg.task = task.task;
+        msg.args = task.args;
+        try {
+            workerObj.port.postMessage(msg);
+        } catch (err) {
+            // Uncloneable args (DataCloneError): the worker never saw the
+            // task, so give back everything taken for it. The error is
+            // delivered on a later tick, as for any rejected submission.
+            this.activeTasks.release(task.id);
+            if (task.bulkhead) this.bulkheadManager.release(task);
+            if (task.probe) this.circuitManager.releaseProbe(task);
+            if (this.rateLimitManager.enabled) this.rateLimitManager.refund(task);
+            workerObj.running--;
+            if (!task.sliced) workerObj.exclusive = false;
+            if (workerObj.running === 0) workerObj.busy = false;
+            this._rejectSubmission(task, err);
+            if (this.drainState) this._checkDrained();
+        } finally {
+            msg.task = null;
+            msg.args = null;
+        }
+    }
+
+    /**
+     * Delivers a task's outcome to its submit() callback or run() promise.
+     */
+    _settle(task, error, result) {
+        if (task.callback !== null) task.callback(error, result);
+        else if (error) task.reject(error);
+        else task.resolve(result);
+    }
+
+    _allocTask() {
+        return this.taskRecords.length > 0 ? this.taskRecords.pop() : createTaskRecord();
+    }
+
+    /**
+     * Returns a settled task's record to the pool. Only called once nothing
+     * (queue, slot table, retry timer) refers to the record any more.
+     */
+    _recycleTask(task) {
+        if (this.taskRecords.length >= TASK_RECORD_POOL_SIZE) return;
+        task.task = null;
+        task.args = null;
+        task.resolve = null;
+        task.reject = null;
+        task.promise = null;
+        task.callback = null;
+        task.group = null;
+        task.worker = null;
+        task.avoidWorker = null;
+        task.retry = null;
+        task.tenant = undefined;
+        task.bulkhead = null;
+        this.taskRecords.push(task);
+    }
+
+    _taskSource(taskFn) {
+        if (typeof taskFn !== 'function') return taskFn;
+        let source = this.taskSources.get(taskFn);
+        if (source === undefined) {
+            source = taskFn.toString();
+            this.taskSources.set(taskFn, source);
+        }
+        return source;
+    }
+
+    /**
+     * Task type used for per-type policies and stats: the explicit name, the
+     * MODULE:/ESM: specifier, or the function name.
+     */
+    _taskType(taskFn, options) {
+        if (options && options.name) return options.name;
+        if (typeof taskFn === 'string') {
+            return /^[A-Z]+:/.test(taskFn) ? taskFn : 'anonymous';
+        }
+        return taskFn.name || 'anonymous';
+    }
+
     run(taskFn, ...args) {
-        if (this.isTerminated) return Promise.reject(new Error('Tasklets instance is terminated'));
-        if (typeof taskFn !== 'function' && typeof taskFn !== 'string') return Promise.reject(new Error('Task must be a function or a string'));
+        // Task configuration object:
+        // { task, args, name, idempotent, maxAttempts, retry, tenant, rateLimit, maxConcurrency, sliced }
+        let options = null;
+        if (this._isDescriptor(taskFn)) {
+            options = taskFn;
+            taskFn = options.task;
+            args = options.args || [];
+        }
+
+        const invalid = this._argsError(args);
+        if (invalid) return Promise.reject(invalid);
+
+        const task = this._allocTask();
+        task.promise = new Promise((resolve, reject) => {
+            task.resolve = resolve;
+            task.reject = reject;
+        });
+        const promise = task.promise;
+        this._submitTask(task, taskFn, args, options);
+        return promise;
+    }
+
+    /**
+     * Low-level submission for hot paths: no Promise is created and args are
+     * not checked, so they must be structured-cloneable. `callback(err, result)`
+     * is always called asynchronously, exactly once. `taskRef` may also be a
+     * task configuration object, as accepted by run(), in which case its
+     * `args` are used.
+     */
+    submit(taskRef, args, callback) {
+        if (typeof callback !== 'function') throw new Error('submit() requires a callback function');
+        this._submit(taskRef, args, callback, null);
+    }
+
+    _submit(taskRef, args, callback, group) {
+        let options = null;
+        if (this._isDescriptor(taskRef)) {
+            options = taskRef;
+            taskRef = options.task;
+            args = options.args;
+        }
 
-        // Validate args are serializable (postMessage uses Structured Clone)
+        const task = this._allocTask();
+        task.callback = callback;
+        task.group = group; // Batch the task belongs to, for cancellation
+        this._submitTask(task, taskRef, args || NO_ARGS, options);
+    }
+
+    _isDescriptor(taskRef) {
+        return !!taskRef && typeof taskRef === 'object' && (typeof taskRef.task === 'function' || typeof taskRef.task === 'string');
+    }
+
+    // Validate args are serializable (postMessage uses Structured Clone)
+    _argsError(args) {
         for (let i = 0; i < args.length; i++) {
             const arg = args[i];
             if (typeof arg === 'function') {
-                return Promise.reject(new Error(
+                return new Error(
                     `Argument at index ${i} is a function. Functions cannot be passed as arguments to worker threads. ` +
                     'Only the task itself (first argument) can be a function. ' +
                     'Use MODULE: prefix to load modules inside the worker. ' +
                     'See: https://github.com/wendelmax/tasklets/blob/main/docs/configuration.md#using-module-prefix'
-                ));
+                );
             }
             if (typeof arg === 'symbol') {
-                return Promise.reject(new Error(
-                    `Argument at index ${i} is a Symbol. Symbols are not serializable via postMessage.`
-                ));
+                return new Error(`Argument at index ${i} is a Symbol. Symbols are not serializable via postMessage.`);
             }
         }
+        return null;
+    }
 
-        return new Promise((resolve, reject) => {
-            // FAST PATH: Try to get a worker immediately
-            const workerObj = this._getWorker();
+    /**
+     * Fails a task before it reached the scheduler. Callbacks are deferred
+     * so submit() never calls back synchronously.
+     */
+    _rejectSubmission(task, error) {
+        if (task.callback !== null) process.nextTick(task.callback, error);
+        else task.reject(error);
+    }
 
-            if (workerObj) {
-                this.metricsManager.recordTaskStart();
-                const taskId = this.nextTaskId++;
-                this.activeTasks.set(taskId, { resolve, reject, startTime: Date.now(), worker: workerObj.worker });
-                workerObj.busy = true;
-
-                workerObj.worker.postMessage({
-                    taskId,
-                    task: typeof taskFn === 'function' ? taskFn.toString() : taskFn,
-                    args,
-                    secret: this.workerSecret
-                });
-            } else {
-                // SLOW PATH: Queue the task if no worker is available
-                this.taskQueue.push({ taskFn, resolve, reject, args, startTime: Date.now() });
-                this._processQueue();
+    /**
+     * Shared by run() and submit(): fills in a task record and either
+     * dispatches it to a free worker or queues it.
+     */
+    _submitTask(task, taskFn, args, options) {
+        if (this.isTerminated) return this._rejectSubmission(task, this._abortError('Tasklets instance is terminated'));
+        if (this.isDraining && !(task.group && task.group.admitted)) {
+            return this._rejectSubmission(task, this._abortError('Tasklets instance is draining'));
+        }
+        if (typeof taskFn !== 'function' && typeof taskFn !== 'string') {
+            return this._rejectSubmission(task, new Error('Task must be a function or a string'));
+        }
+
+        task.task = this._taskSource(taskFn);
+        task.args = args;
+        task.startTime = clock.now();
+        task.type = this._taskType(taskFn, options);
+        task.idempotent = !!(options && options.idempotent);
+        task.maxAttempts = (options && options.maxAttempts) || 3;
+        task.crashes = 0;
+        task.retry = options ? RetryManager.normalizePolicy(options.retry) : null;
+        task.attempts = 0;          // Dispatches so far, including retries and crash re-queues
+        task.notBefore = 0;         // Held in the queue until then (retry backoff)
+        task.lastDelay = 0;
+        task.probe = false;         // Half-open circuit probe (see circuit.js)
+        task.evicted = false;       // Requeued from a worker terminated over another task's timeout
+        task.tenant = options ? options.tenant : undefined;
+        task.rateHeld = false;
+        task.bulkheadHeld = false;  // bulkhead: slot held while running (see bulkhead.js)
+        task.sliced = !!(options && options.sliced); // Calls tasklet.yield(), may share a worker
+
+        if (options && (options.rateLimit || options.maxConcurrency !== undefined)) {
+            try {
+                if (options.rateLimit) this.rateLimitManager.addTaskLimit(task.type, options.rateLimit, clock.now());
+                if (options.maxConcurrency !== undefined) this.bulkheadManager.addTaskLimit(task.type, options.maxConcurrency);
+            } catch (err) {
+                return this._rejectSubmission(task, err);
             }
+        }
+
+        // Fail fast on the main thread while the type's circuit is open
+        if (this.circuitManager.enabled && !this.circuitManager.admit(task)) {
+            return this._rejectSubmission(task, this.circuitManager.rejectionError(task));
+        }
+
+        // FAST PATH: Try to get a worker immediately (unless rate limited or bulkheaded)
+        const held = (this.bulkheadManager.enabled && this.bulkheadManager.heldBy(task) !== null) ||
+            (this.rateLimitManager.enabled && this.rateLimitManager.heldBy(task, clock.now()) !== null);
+        const workerObj = held ? null : this._getWorker(task);
+
+        if (workerObj) {
+            this._dispatch(workerObj, task);
+        } else {
+            // SLOW PATH: Queue the task if no worker is available
+            this.taskQueue.push(task);
+            this._processQueue();
+        }
+    }
+
+    /**
+     * Runs tasks[i] for every i in `indices` (all of them when null) on the
+     * callback path, keeping at most `options.concurrency` of them queued or
+     * running. With `options.failFast`, the first failure stops the batch:
+     * tasks not yet submitted and tasks still waiting in the pool queue are
+     * reported to `onResult` with a shared error marked `cancelled`, while
+     * tasks already running finish normally. run()'s argument checks still
+     * apply. If `onResult` returns true, the batch stops the same way and
+     * running tasks are also asked to stop (see _abortGroup). If `onResult`
+     * throws, the batch stops and `onDone` receives that error. Returns the
+     * batch's group, for callers that cancel it themselves.
+     */
+    _submitAll(tasks, indices, options, onResult, onDone) {
+        const total = indices ? indices.length : tasks.length;
+        const concurrency = options.concurrency;
+        if (concurrency !== undefined && (!Number.isInteger(concurrency) || concurrency < 1)) {
+            return onDone(new Error('concurrency must be a positive integer'));
+        }
+        if (total === 0) return onDone(null);
+
+        const group = this._openGroup(total);
+        let submitted = 0;
+        let remaining = total;
+        let finished = false;
+
+        const submitNext = () => {
+            const index = indices ? indices[submitted++] : submitted++;
+            const t = tasks[index];
+            const invalid = this._isDescriptor(t) && t.args ? this._argsError(t.args) : null;
+            const callback = (err, result) => deliver(index, err, result);
+            if (invalid) process.nextTick(callback, invalid);
+            else this._submit(t, undefined, callback, group);
+            this._releaseHeld(group, 1);
+        };
+
+        const stop = (error) => {
+            group.stopped = true;
+            this._cancelGroup(group, error);
+            this._releaseHeld(group, group.held);
+            while (submitted < total) deliver(indices ? indices[submitted++] : submitted++, error, undefined);
+        };
+
+        const deliver = (index, err, result) => {
+            if (finished) return;
+            let done;
+            try {
+                done = onResult(index, err, result) === true;
+            } catch (callbackError) {
+                finished = true;
+                stop(callbackError);
+                return onDone(callbackError);
+            }
+            if (--remaining === 0) {
+                finished = true;
+                return onDone(null);
+            }
+            if (group.stopped) return;
+            if (done || (err && options.failFast)) {
+                const cancelled = new Error(done
+                    ? 'Cancelled: the batch already has the results it needs'
+                    : 'Cancelled: an earlier task in the batch failed');
+                cancelled.cancelled = true;
+                if (done) this._abortGroup(group);
+                return stop(cancelled);
+            }
+            if (submitted < total) submitNext();
+        };
+
+        const initial = concurrency ? Math.min(concurrency, total) : total;
+        while (submitted < initial) submitNext();
+        return group;
+    }
+
+    /**
+     * A batch that submits its tasks over time (concurrency limits, scan()).
+     * `held` counts tasks not submitted yet. A batch opened before drain()
+     * may keep submitting while it runs, and the drain waits for it.
+     */
+    _openGroup(held) {
+        const group = { stopped: false, admitted: !this.isDraining, held };
+        if (group.admitted && held > 0) this.openGroups.add(group);
+        return group;
+    }
+
+    _releaseHeld(group, count) {
+        group.held -= count;
+        if (group.held > 0 || !this.openGroups.delete(group)) return;
+        if (this.drainState) this._checkDrained();
+    }
+
+    /**
+     * Removes a batch's tasks from the pool queue and fails them with `error`.
+     */
+    _cancelGroup(group, error) {
+        const queue = this.taskQueue;
+        const cancelled = [];
+        let kept = 0;
+        for (let i = 0; i < queue.length; i++) {
+            const task = queue[i];
+            if (task.group === group) cancelled.push(task);
+            else queue[kept++] = task;
+        }
+        queue.length = kept;
+        if (this.parkedCount > 0) cancelled.push(...this._takeParked(task => task.group === group));
+
+        for (const task of cancelled) {
+            if (task.probe) this.circuitManager.releaseProbe(task);
+            this._settle(task, error);
+            this._recycleTask(task);
+        }
+        if (this.drainState) this._checkDrained();
+    }
+
+    /**
+     * Asks a batch's running tasks to stop. Cancellation is cooperative: the
+     * task sees it through `tasklet.cancelled` / `tasklet.throwIfCancelled()`
+     * and otherwise runs to completion. The shared flag reaches tasks busy
+     * in a synchronous loop; the message covers tasks sharing a worker under
+     * time slicing, which read it when they yield.
+     */
+    _abortGroup(group) {
+        this.activeTasks.forEach((task, taskId) => {
+            if (task.group !== group) return;
+            const workerObj = this.workerPool.find(w => w.worker === task.worker);
+            if (!workerObj) return;
+            Atomics.store(workerObj.cancelFlag, 0, taskId);
+            workerObj.port.postMessage({ type: 'cancel', taskId });
         });
     }
 
+    /**
+     * Runs every task and resolves with their results in order; a failed
+     * task contributes its Error instead of rejecting the whole call.
+     * Options: `concurrency`, `failFast` (see _submitAll).
+     */
+    runAll(tasks, options = {}) {
+        if (!Array.isArray(tasks)) {
+            return Promise.reject(new Error('Tasks must be an array of functions or task configuration objects'));
+        }
+        return new Promise((resolve, reject) => {
+            const results = new Array(tasks.length);
+            this._submitAll(tasks, null, options, (index, err, result) => {
+                results[index] = err || result;
+            }, (err) => (err ? reject(err) : resolve(results)));
+        });
+    }
 
-    async runAll(tasks) {
+    /**
+     * Scatter-gather: resolves with the first `k` successful results, in
+     * completion order, as soon as they are in. The remaining tasks are
+     * dropped from the queue and running ones are asked to stop. Rejects
+     * with an AggregateError once too many tasks have failed for `k` to be
+     * reached.
+     */
+    any(tasks, options = {}) {
         if (!Array.isArray(tasks)) {
             return Promise.reject(new Error('Tasks must be an array of functions or task configuration objects'));
         }
-        return Promise.all(tasks.map(async t => {
-            try {
-                if (typeof t === 'function') {
-                    return await this.run(t);
-                } else if (t && (typeof t.task === 'function' || typeof t.task === 'string')) {
-                    return await this.run(t.task, ...(t.args || []));
+        const k = options.k !== undefined ? options.k : 1;
+        if (!Number.isInteger(k) || k < 1 || k > tasks.length) {
+            return Promise.reject(new Error('k must be an integer between 1 and the number of tasks'));
+        }
+
+        return new Promise((resolve, reject) => {
+            const results = [];
+            const errors = [];
+            let settled = false;
+            this._submitAll(tasks, null, { concurrency: options.concurrency }, (index, err, result) => {
+                if (settled) return false;
+                if (!err) {
+                    results.push(result);
+                    if (results.length < k) return false;
+                    settled = true;
+                    resolve(results);
+                    return true;
+                }
+                errors.push(err);
+                if (errors.length <= tasks.length - k) return false;
+                settled = true;
+                reject(new AggregateError(errors, `Only ${results.length} of ${tasks.length} tasks succeeded, ${k} required`));
+                return true;
+            }, (err) => {
+                if (!settled && err) reject(err);
+            });
+        });
+    }
+
+    /**
+     * Parallel search: runs `predicate(item, index)` over every chunk, one
+     * task per chunk, and resolves with `{ chunk, index, value }` for a
+     * match, or undefined. All tasks share one found-flag in shared memory;
+     * the first match sets it and the other scans stop at their next
+     * element. The match is the first one found, not necessarily the one at
+     * the lowest position. `predicate` runs in a worker, so it must be
+     * self-contained.
+     */
+    find(chunks, predicate, options = {}) {
+        if (!Array.isArray(chunks)) return Promise.reject(new Error('Chunks must be an array'));
+        if (typeof predicate !== 'function' && typeof predicate !== 'string') {
+            return Promise.reject(new Error('Predicate must be a function or a string'));
+        }
+
+        const found = new SharedArrayBuffer(4);
+        const source = this._taskSource(predicate);
+        const tasks = chunks.map(chunk => ({ task: 'BUILTIN:find', name: 'find', args: [source, chunk, found] }));
+
+        return new Promise((resolve, reject) => {
+            let settled = false;
+            this._submitAll(tasks, null, { concurrency: options.concurrency }, (chunk, err, hit) => {
+                if (settled || (!err && hit === null)) return false;
+                settled = true;
+                if (err) {
+                    Atomics.store(new Int32Array(found), 0, 1); // Stop the other scans
+                    reject(err);
                 } else {
-                    return await this.run(t); // Will trigger validation error
+                    resolve({ chunk, index: hit.index, value: hit.value });
                 }
-            } catch (err) {
-                return err;
+                return true;
+            }, (err) => {
+                if (settled) return;
+                settled = true;
+                if (err) reject(err);
+                else resolve(undefined);
+            });
+        });
+    }
+
+    /**
+     * Regex scan of a large Buffer/Uint8Array or file, split into chunks
+     * scanned in parallel. Yields `{ offset, match }` in input order, with
+     * byte offsets. Chunks are line-aligned by default, or overlap by
+     * `overlap` bytes (at least the longest possible match) for patterns
+     * that span lines. At most `concurrency` chunks are in flight or
+     * waiting to be consumed, so a slow consumer holds back the scan.
+     * Stopping iteration early cancels the remaining chunks.
+     */
+    async *scan(input, pattern, options = {}) {
+        const chunkSize = options.chunkSize !== undefined ? options.chunkSize : 8 * 1024 * 1024;
+        const overlap = options.overlap !== undefined ? options.overlap : null;
+        const encoding = options.encoding || 'latin1';
+        if (!Number.isInteger(chunkSize) || chunkSize < 1) throw new Error('chunkSize must be a positive integer');
+        if (overlap !== null && (!Number.isInteger(overlap) || overlap < 0)) throw new Error('overlap must be a non-negative integer');
+        if (encoding !== 'latin1' && encoding !== 'utf8') throw new Error("encoding must be 'latin1' or 'utf8'");
+        if (!(pattern instanceof RegExp) && typeof pattern !== 'string') throw new Error('Pattern must be a RegExp or a string');
+
+        const source = pattern instanceof RegExp ? pattern.source : pattern;
+        const flags = pattern instanceof RegExp ? pattern.flags.replace(/[gy]/g, '') + 'g' : 'g';
+        const nextChunk = this._scanChunks(input, chunkSize, overlap);
+
+        const window = options.concurrency || this.maxWorkers * 2;
+        // The chunk count is not known up front: hold one until the input is exhausted
+        const group = this._openGroup(1);
+        const results = new Map(); // chunk index -> { offsets, matches }
+        let failure = null;
+        let wake = null;
+        let submitted = 0;
+        let exhausted = false;
+        let completed = false;
+        let lastEnd = 0; // Byte offset where the last reported match ends
+
+        const submitUpTo = (limit) => {
+            while (!exhausted && submitted < limit) {
+                const chunk = nextChunk();
+                if (chunk === null) {
+                    exhausted = true;
+                    this._releaseHeld(group, group.held);
+                    return;
+                }
+                const index = submitted++;
+                const spec = { source, flags, encoding, overlap, ...chunk };
+                this._submit({ task: 'BUILTIN:scan', name: 'scan', args: [spec] }, undefined, (err, res) => {
+                    if (err) failure = failure || err;
+                    else results.set(index, res);
+                    if (wake) {
+                        const resume = wake;
+                        wake = null;
+                        resume();
+                    }
+                }, group);
             }
+        };
+
+        try {
+            for (let next = 0; ; next++) {
+                submitUpTo(next + window);
+                if (next >= submitted) {
+                    completed = true;
+                    return;
+                }
+                while (!results.has(next) && !failure) await new Promise(resolve => { wake = resolve; });
+                if (failure) throw failure;
+
+                const { offsets, matches } = results.get(next);
+                results.delete(next);
+                for (let i = 0; i < offsets.length; i++) {
+                    // In overlap mode a chunk may start inside a match that an
+                    // earlier chunk already reported; drop its tail
+                    if (offsets[i] < lastEnd) continue;
+                    if (overlap !== null) {
+                        lastEnd = offsets[i] + (encoding === 'utf8' ? Buffer.byteLength(matches[i], 'utf8') : matches[i].length);
+                    }
+                    yield { offset: offsets[i], match: matches[i] };
+                }
+            }
+        } finally {
+            // Consumer stopped early (break) or a chunk failed
+            if (!completed) {
+                group.stopped = true;
+                if (group.held > 0) this._releaseHeld(group, group.held);
+                const cancelled = new Error('Cancelled: the scan was stopped');
+                cancelled.cancelled = true;
+                this._cancelGroup(group, cancelled);
+                this._abortGroup(group);
+            }
+        }
+    }
+
+    /**
+     * Returns a function producing the next scan chunk spec, or null when
+     * done. Buffers are split here (line edges found with indexOf) and each
+     * chunk carries its bytes, shared when the input lives in a
+     * SharedArrayBuffer and copied otherwise. Files are split into nominal
+     * ranges that the worker reads and aligns itself.
+     */
+    _scanChunks(input, chunkSize, overlap) {
+        if (typeof input === 'string') {
+            const size = fs.statSync(input).size;
+            let start = 0;
+            return () => {
+                if (start >= size) return null;
+                const chunk = { path: input, start, end: Math.min(start + chunkSize, size) };
+                start = chunk.end;
+                return chunk;
+            };
+        }
+        if (!(input instanceof Uint8Array)) throw new Error('Input must be a Buffer, a Uint8Array or a file path');
+
+        const total = input.length;
+        const shared = input.buffer instanceof SharedArrayBuffer;
+        let start = 0;
+        return () => {
+            if (start >= total) return null;
+            let end = Math.min(start + chunkSize, total);
+            if (overlap === null && end < total) {
+                const nl = input.indexOf(0x0A, end - 1);
+                end = nl === -1 ? total : nl + 1;
+            }
+            const to = overlap === null ? end : Math.min(end + overlap, total);
+            // Leading context for \b, ^ and lookbehinds (see builtins/scan.js)
+            const context = Math.min(start, overlap === null ? 1 : overlap);
+            const from = start - context;
+            const bytes = shared
+                ? new Uint8Array(input.buffer, input.byteOffset + from, to - from)
+                : Uint8Array.prototype.slice.call(input, from, to);
+            const chunk = { bytes, base: start, reportEnd: end, context };
+            start = end;
+            return chunk;
+        };
+    }
+
+    /**
+     * Bulk-synchronous run: each partition is sent once to its own worker,
+     * where a BUILTIN:bsp task keeps it across supersteps. Every superstep
+     * runs step(partition, ctx) on all partitions; the main thread is the
+     * barrier, woken through Atomics.waitAsync when the last partition
+     * arrives, and sees only each partition's numeric aggregate. Partitions
+     * exchange boundary data through SharedArrayBuffers in `shared`.
+     */
+    bsp(partitions, step, options = {}) {
+        const { maxSteps = 100, aggregateSize = 1, until, shared, collect = false, startTimeoutMs = 10000 } = options;
+        try {
+            if (!Array.isArray(partitions) || partitions.length === 0) throw new Error('Partitions must be a non-empty array');
+            if (typeof step !== 'function' && typeof step !== 'string') throw new Error('Step must be a function or a string');
+            if (!Number.isInteger(maxSteps) || maxSteps < 1) throw new Error('maxSteps must be a positive integer');
+            if (!Number.isInteger(aggregateSize) || aggregateSize < 1) throw new Error('aggregateSize must be a positive integer');
+            if (until !== undefined && typeof until !== 'function') throw new Error('until must be a function');
+            if (!Number.isInteger(startTimeoutMs) || startTimeoutMs < 1) throw new Error('startTimeoutMs must be a positive integer');
+            // Every partition blocks its worker between supersteps
+            const capacity = Math.min(this.maxWorkers, this._workerCapacity());
+            if (partitions.length > capacity) {
+                throw new Error(`bsp() needs one worker per partition: ${partitions.length} partitions, ${capacity} workers available`);
+            }
+        } catch (err) {
+            return Promise.reject(err);
+        }
+
+        const count = partitions.length;
+        const control = new Int32Array(new SharedArrayBuffer(16));
+        const aggregates = new Float64Array(new SharedArrayBuffer(count * aggregateSize * 8));
+        const source = this._taskSource(step);
+        const tasks = partitions.map((partition, index) => ({
+            task: 'BUILTIN:bsp',
+            name: 'bsp',
+            args: [source, partition, index, count, shared, control.buffer, aggregates.buffer, aggregateSize, collect]
         }));
+        control[BSP_RELEASED] = 1; // Release superstep 0
+
+        return new Promise((resolve, reject) => {
+            const results = new Array(count);
+            let failure = null;
+            let steps = 0;
+            let last = null;
+
+            const halt = (err) => {
+                if (err && !failure) failure = err;
+                Atomics.store(control, BSP_STOP, 1);
+                Atomics.notify(control, BSP_RELEASED);
+                Atomics.notify(control, BSP_ARRIVED);
+            };
+
+            let done;
+            const finished = new Promise(resolve => { done = resolve; });
+            const group = this._submitAll(tasks, null, {}, (index, err, result) => {
+                if (err) {
+                    halt(err);
+                    return true; // Cancel partitions still queued
+                }
+                results[index] = result;
+                return false;
+            }, done);
+
+            // Started partitions wait for the others at the first barrier,
+            // holding their workers. If the rest never get a worker (busy
+            // pool, memory pressure), give up instead of wedging them.
+            const startTimer = setTimeout(() => {
+                const started = Atomics.load(control, BSP_STARTED);
+                if (started >= count || failure) return;
+                const err = new Error(`bsp() could not start all partitions: ${started} of ${count} running after ${startTimeoutMs}ms`);
+                halt(err);
+                if (group) this._cancelGroup(group, err);
+            }, startTimeoutMs);
+
+            const run = async () => {
+                while (!failure) {
+                    let arrived;
+                    while (!failure && (arrived = Atomics.load(control, BSP_ARRIVED)) < count) {
+                        const wait = Atomics.waitAsync(control, BSP_ARRIVED, arrived);
+                        if (wait.async) await wait.value;
+                    }
+                    if (failure) return;
+
+                    last = aggregateSize === 1
+                        ? Array.from(aggregates)
+                        : partitions.map((p, i) => aggregates.slice(i * aggregateSize, (i + 1) * aggregateSize));
+                    steps++;
+                    Atomics.store(control, BSP_ARRIVED, 0);
+                    if (steps >= maxSteps || (until && until(last, steps - 1) === true)) return;
+                    Atomics.store(control, BSP_RELEASED, steps + 1);
+                    Atomics.notify(control, BSP_RELEASED);
+                }
+            };
+
+            run().then(() => halt(null), halt);
+            finished.then((err) => {
+                clearTimeout(startTimer);
+                if (err || failure) reject(failure || err);
+                else resolve(collect ? { steps, aggregates: last, partitions: results } : { steps, aggregates: last });
+            });
+        });
+    }
+
+    /**
+     * Estimates the mean of fn(random, i) over `samples` draws. Samples are
+     * cut into fixed chunks of `chunkSize`, and chunk c draws from Philox
+     * stream (seed, c), so the result depends only on seed, samples and
+     * chunkSize, not on worker count or completion order. Chunk statistics
+     * are merged in chunk order on the main thread.
+     */
+    monteCarlo(samples, fn, options = {}) {
+        const { chunkSize = 65536 } = options;
+        const seed = options.seed === undefined ? Math.floor(Math.random() * 2 ** 53) : options.seed;
+        try {
+            if (!Number.isSafeInteger(samples) || samples < 1) throw new Error('samples must be a positive integer');
+            if (typeof fn !== 'function' && typeof fn !== 'string') throw new Error('fn must be a function or a string');
+            if (!Number.isSafeInteger(seed) || seed < 0) throw new Error('seed must be a non-negative safe integer');
+            if (!Number.isInteger(chunkSize) || chunkSize < 1) throw new Error('chunkSize must be a positive integer');
+        } catch (err) {
+            return Promise.reject(err);
+        }
+
+        const source = this._taskSource(fn);
+        const key0 = seed % 4294967296;
+        const key1 = Math.floor(seed / 4294967296);
+        const chunks = Math.ceil(samples / chunkSize);
+        const tasks = new Array(chunks);
+        for (let c = 0; c < chunks; c++) {
+            const start = c * chunkSize;
+            tasks[c] = {
+                task: 'BUILTIN:montecarlo',
+                name: 'monteCarlo',
+                args: [source, key0, key1, c, start, Math.min(chunkSize, samples - start)]
+            };
+        }
+
+        return new Promise((resolve, reject) => {
+            const results = new Array(chunks);
+            let failure = null;
+            this._submitAll(tasks, null, { concurrency: options.concurrency }, (c, err, result) => {
+                if (err) {
+                    if (!failure) failure = err;
+                    return true; // Stop the other chunks
+                }
+                results[c] = result;
+                return false;
+            }, (err) => {
+                if (err || failure) return reject(err || failure);
+                // Chan et al. pairwise update, always in chunk order
+                let n = 0, mean = 0, m2 = 0;
+                for (const r of results) {
+                    const total = n + r.count;
+                    const delta = r.mean - mean;
+                    mean += delta * r.count / total;
+                    m2 += r.m2 + delta * delta * n * r.count / total;
+                    n = total;
+                }
+                const variance = n > 1 ? m2 / (n - 1) : 0;
+                resolve({ samples: n, mean, variance, stdError: Math.sqrt(variance / n), seed });
+            });
+        });
+    }
+
+    /**
+     * C = A x B for row-major `{ rows, cols, data }` matrices whose data is a
+     * Float64Array or Float32Array. Inputs are copied into shared memory
+     * unless they already live in a SharedArrayBuffer; C is split into
+     * tiles computed by workers in place, so no matrix data is cloned per
+     * task. Resolves with C, backed by a SharedArrayBuffer.
+     */
+    matmul(A, B) {
+        try {
+            for (const M of [A, B]) {
+                if (!M || !(M.data instanceof Float64Array || M.data instanceof Float32Array)) {
+                    throw new Error('Matrices must be { rows, cols, data } with Float64Array or Float32Array data');
+                }
+                if (!Number.isInteger(M.rows) || !Number.isInteger(M.cols) || M.rows * M.cols !== M.data.length) {
+                    throw new Error('Matrix data length must equal rows x cols');
+                }
+            }
+            if (A.data.constructor !== B.data.constructor) throw new Error('Matrices must have the same element type');
+            if (A.cols !== B.rows) throw new Error(`Cannot multiply ${A.rows}x${A.cols} by ${B.rows}x${B.cols}`);
+        } catch (err) {
+            return Promise.reject(err);
+        }
+        const m = A.rows;
+        const k = A.cols;
+        const n = B.cols;
+        const Type = A.data.constructor;
+
+        const c = new Type(new SharedArrayBuffer(m * n * Type.BYTES_PER_ELEMENT));
+        const result = { rows: m, cols: n, data: c };
+        if (m === 0 || n === 0 || k === 0) return Promise.resolve(result);
+
+        const a = this._sharedCopy(A.data);
+        const b = this._sharedCopy(B.data);
+
+        // About four tiles per worker for load balance. Wide, short results
+        // are split by columns as well, in multiples of 64 columns.
+        const target = this.maxWorkers * 4;
+        const rowTiles = Math.min(m, target);
+        const colTiles = Math.max(1, Math.min(Math.ceil(n / 64), Math.ceil(target / rowTiles)));
+        const rowStep = Math.ceil(m / rowTiles);
+        const colStep = Math.ceil(n / colTiles);
+        const tasks = [];
+        for (let i0 = 0; i0 < m; i0 += rowStep) {
+            for (let j0 = 0; j0 < n; j0 += colStep) {
+                const spec = { a, b, c, k, n, i0, i1: Math.min(i0 + rowStep, m), j0, j1: Math.min(j0 + colStep, n) };
+                tasks.push({ task: 'BUILTIN:matmul', name: 'matmul', args: [spec] });
+            }
+        }
+
+        return new Promise((resolve, reject) => {
+            let failure = null;
+            this._submitAll(tasks, null, {}, (index, err) => {
+                if (err && !failure) {
+                    failure = err;
+                    return true; // Stop the other tiles
+                }
+                return false;
+            }, (err) => {
+                if (err || failure) reject(err || failure);
+                else resolve(result);
+            });
+        });
+    }
+
+    /**
+     * The typed array itself when it already lives in shared memory,
+     * otherwise a copy in a new SharedArrayBuffer.
+     */
+    _sharedCopy(data) {
+        if (data.buffer instanceof SharedArrayBuffer) return data;
+        const copy = new data.constructor(new SharedArrayBuffer(data.byteLength));
+        copy.set(data);
+        return copy;
     }
 
     async batch(tasks, options = {}) {
@@ -308,59 +1608,156 @@ class Tasklets extends EventEmitter {
             }
         }
 
-        let completed = 0;
+        if (!options.journal) {
+            return this._runBatch(tasks, new Array(tasks.length), options, null);
+        }
+
+        // Durable mode: persist the serialized task list up-front so the job
+        // can be rebuilt by resumeBatch() after a restart.
+        const descriptors = tasks.map((t, index) => {
+            // Task options (idempotent, maxAttempts, ...) are kept so a resumed
+            // job runs under the same policies.
+            const { task, args, ...taskOptions } = typeof t === 'function' ? { task: t } : t;
+            return {
+                ...taskOptions,
+                name: t.name || `task-${index}`,
+                task: typeof task === 'function' ? task.toString() : task,
+                args: args || []
+            };
+        });
+        const journal = BatchJournal.create(options.journal, descriptors, options);
+        return this._runBatch(descriptors, new Array(tasks.length), options, journal);
+    }
+
+    async resumeBatch(journalPath, options = {}) {
+        if (typeof journalPath !== 'string') return Promise.reject(new Error('Journal path must be a string'));
+
+        const journal = BatchJournal.open(journalPath, options);
+        const tasks = journal.getTasks();
+        const results = new Array(tasks.length);
+        for (const [index, entry] of journal.entries) {
+            results[index] = entry;
+        }
+        this._log('info', `Resuming batch from ${journalPath}: ${journal.entries.size}/${tasks.length} tasks already completed`);
+        return this._runBatch(tasks, results, options, journal);
+    }
+
+    _runBatch(tasks, results, options, journal) {
         const total = tasks.length;
+        let completed = 0;
+        const pending = [];
 
-        const results = await Promise.all(tasks.map(async (t, index) => {
-            const name = t.name || `task-${index}`;
-            try {
-                let res;
-                if (typeof t === 'function') {
-                    res = await this.run(t);
-                } else {
-                    res = await this.run(t.task, ...(t.args || []));
-                }
+        for (let index = 0; index < total; index++) {
+            if (results[index] !== undefined) completed++;
+            else pending.push(index);
+        }
 
-                completed++;
-                if (options.onProgress) {
-                    options.onProgress({ completed, total, percentage: (completed / total) * 100 });
+        return new Promise((resolve, reject) => {
+            this._submitAll(tasks, pending, options, (index, err, result) => {
+                const t = tasks[index];
+                const name = t.name || `task-${index}`;
+                if (err && err.cancelled) {
+                    // Not journaled: a resumed batch runs it again
+                    results[index] = { name, success: false, cancelled: true, error: err.message };
+                    return;
+                }
+                if (err && err.aborted) {
+                    // The pool shut down or gave up draining: also left for resume
+                    results[index] = { name, success: false, aborted: true, error: err.message };
+                    return;
                 }
+                const entry = err
+                    ? { name, success: false, error: err.message }
+                    : { name, result, success: true };
+                results[index] = entry;
+                if (journal) journal.record(index, entry);
 
-                return { name, result: res, success: true };
-            } catch (err) {
                 completed++;
                 if (options.onProgress) {
                     options.onProgress({ completed, total, percentage: (completed / total) * 100 });
                 }
-                return { name, success: false, error: err.message };
-            }
-        }));
+            }, (err) => {
+                if (journal) journal.close();
+                if (err) return reject(err);
 
-        // Delegate to AdaptiveManager
-        this.adaptiveManager.optimizeForBatch(total);
-
-        return results;
+                // Delegate to AdaptiveManager
+                this.adaptiveManager.optimizeForBatch(total);
+                resolve(results);
+            });
+        });
     }
 
+    /**
+     * Runs a task under a retry policy handled by the scheduler: failed
+     * attempts are re-queued with the serialized task and args, delayed by
+     * decorrelated jitter (or `delay * backoff^n` with `jitter: false`),
+     * preferably on a different worker, and subject to the retry budget.
+     */
     async retry(taskFn, options = {}) {
         const attempts = options.attempts || 3;
         const delay = options.delay || 0;
         const backoff = options.backoff || 1;
 
-        let lastError;
+        const descriptor = taskFn && typeof taskFn === 'object' ? { ...taskFn } : { task: taskFn };
+        if (options.args !== undefined) descriptor.args = options.args;
+        if (options.name !== undefined) descriptor.name = options.name;
+        descriptor.retry = {
+            attempts,
+            baseDelay: delay,
+            // Room for jitter: at least 3x the base delay, or the deterministic
+            // schedule's last step when that is longer
+            maxDelay: options.maxDelay !== undefined
+                ? options.maxDelay
+                : Math.max(delay * 3, delay * Math.pow(Math.max(backoff, 1), Math.max(attempts - 2, 0))),
+            backoff,
+            jitter: options.jitter !== false,
+            differentWorker: options.differentWorker,
+            // Only spend a retry budget the pool was configured with
+            budget: this.retryManager.budgetConfigured
+        };
+        return this.run(descriptor);
+    }
 
-        for (let i = 0; i < attempts; i++) {
-            try {
-                return await this.run(taskFn);
-            } catch (err) {
-                lastError = err;
-                if (i < attempts - 1) {
-                    const waitTime = delay * Math.pow(backoff, i);
-                    if (waitTime > 0) await new Promise(r => setTimeout(r, waitTime));
-                }
+    /**
+     * Picks up a changed MODULE:/ESM: task file without restarting the pool.
+     *
+     * - `mode: 'roll'` (default): starts a replacement for every worker up
+     *   front. Old workers stop taking work and each exits after its current
+     *   task, independently of the others, so capacity never drops.
+     * - `mode: 'invalidate'`: drops the module from every worker's caches in
+     *   place. Only the file itself is reloaded, so use it for stateless
+     *   modules whose dependencies did not change.
+     */
+    async reloadModule(modulePath, options = {}) {
+        if (this.isTerminated) throw new Error('Tasklets instance is terminated');
+        if (typeof modulePath !== 'string') throw new Error('Module path must be a string');
+        const mode = options.mode || 'roll';
+        const target = modulePath.replace(/^(MODULE|ESM):/, '').replace(/#[^/]*$/, '');
+
+        if (mode === 'invalidate') {
+            // Port messages are ordered: tasks dispatched after this see the new code
+            for (const w of this.workerPool) {
+                w.port.postMessage({ type: 'reload', path: target });
             }
+            this._log('info', `Invalidated ${target} in ${this.workerPool.length} workers`);
+            return { mode, workers: this.workerPool.length };
         }
-        throw lastError;
+        if (mode !== 'roll') throw new Error(`Unknown reload mode: ${mode}`);
+
+        // New tasks land on the fresh workers while busy old ones finish
+        const previous = this.workerPool.filter(w => !w.retiring);
+        const exits = previous.map((old) => {
+            this._spawnWorker();
+            const exited = new Promise(resolve => old.worker.once('exit', resolve));
+            if (old.busy) old.retiring = true;
+            else this._retireWorker(old);
+            return exited;
+        });
+        this._processQueue();
+        await Promise.all(exits);
+
+        this._log('info', `Reloaded ${target} by rolling ${previous.length} workers`);
+        return { mode, workers: previous.length };
     }
 
     enableAdaptiveMode() {
@@ -386,6 +1783,7 @@ class Tasklets extends EventEmitter {
                 const val = parseInt(config.maxWorkers, 10);
                 if (!isNaN(val)) this.maxWorkers = val;
             }
+            if (!this.isTerminated) this._resizePool();
         }
         if (config.minWorkers !== undefined) {
             const val = parseInt(config.minWorkers, 10);
@@ -408,6 +1806,22 @@ class Tasklets extends EventEmitter {
         }
         if (config.allowedModules !== undefined) this.allowedModules = config.allowedModules;
         if (config.workload !== undefined) this.setWorkloadType(config.workload);
+        if (config.timeSlicing !== undefined) {
+            this._configureTimeSlicing(config.timeSlicing);
+            this._processQueue();
+        }
+        if (config.affinity !== undefined) this.affinityManager.configure(config.affinity);
+        if (config.retry !== undefined) this.retryManager.configure(config.retry);
+        if (config.circuitBreaker !== undefined) this.circuitManager.configure(config.circuitBreaker);
+        if (config.rateLimit !== undefined) {
+            this.rateLimitManager.configure(config.rateLimit, clock.now());
+            this._processQueue();
+        }
+        if (config.bulkheads !== undefined) {
+            this.bulkheadManager.configure(config.bulkheads);
+            this._processQueue();
+        }
+        if (config.resultBatching !== undefined) this._configureResultBatching(config.resultBatching);
         if (config.adaptive === true) this.enableAdaptiveMode();
         return this;
     }
@@ -418,12 +1832,24 @@ class Tasklets extends EventEmitter {
             activeTasks: this.activeTasks.size,
             activeWorkers: this.workerPool.filter(w => w.busy).length,
             totalWorkers: this.workerPool.length,
-            queuedTasks: this.taskQueue.length,
+            queuedTasks: this.taskQueue.length + this.parkedCount,
+            recovery: { ...this.recoveryStats },
+            retries: this.retryManager.getStats(),
+            circuits: this.circuitManager.getStats(),
+            rateLimits: this.rateLimitManager.getStats(),
+            bulkheads: this.bulkheadManager.getStats(),
+            resultBatching: {
+                ...this.batchStats,
+                avgBatch: this.batchStats.batches > 0 ? this.batchStats.delivered / this.batchStats.batches : 0
+            },
             idleWorkers: this.workerPool.filter(w => !w.busy).length,
             throughput: metrics.throughput,
             avgTaskTime: metrics.avgTaskTime,
+            avgCpuTime: metrics.avgCpuTime,
+            taskTimePercentiles: metrics.taskTimePercentiles,
             totalTasks: this.metricsManager.totalTasks,
-            processedTasks: this.metricsManager.processedTasks,
+            processedTasks: metrics.processedTasks,
+            failedTasks: metrics.failedTasks,
             config: {
                 maxWorkers: this.maxWorkers,
                 minWorkers: this.minWorkers,
@@ -431,7 +1857,10 @@ class Tasklets extends EventEmitter {
                 timeout: this.globalTimeout,
                 logging: this.loggingLevel,
                 maxMemory: this.maxMemory,
-                allowedModules: this.allowedModules
+                allowedModules: this.allowedModules,
+                affinity: this.affinityManager.getConfig(),
+                timeSlicing: this.timeSlicing ? { ...this.timeSlicing } : null,
+                resultBatching: this.resultBatching ? { ...this.resultBatching } : null
             }
         };
     }
@@ -446,10 +1875,135 @@ class Tasklets extends EventEmitter {
         };
     }
 
+    /**
+     * Stops admission and waits for in-flight and queued tasks to finish.
+     * Tasks still pending after timeoutMs are rejected and their workers
+     * terminated. Admission stays closed until resume() is called.
+     */
+    drain(options = {}) {
+        if (this.isTerminated) return Promise.reject(new Error('Tasklets instance is terminated'));
+        if (this.drainState) return this.drainState.promise;
+
+        this.isDraining = true;
+        const totals = this.metricsManager.shared.aggregate();
+        const state = {
+            startTime: clock.now(),
+            pending: this.activeTasks.size + this.taskQueue.length + this.parkedCount + this._heldTasks(),
+            baseCompleted: totals.completed,
+            baseFailed: totals.failed,
+            timer: null
+        };
+        state.promise = new Promise(resolve => { state.resolve = resolve; });
+        this.drainState = state;
+        this._log('info', `Draining ${state.pending} tasks`);
+
+        const timeoutMs = parseInt(options.timeoutMs, 10);
+        if (timeoutMs > 0) {
+            state.timer = setTimeout(() => this._finishDrain(true), timeoutMs);
+        }
+
+        this._checkDrained();
+        return state.promise;
+    }
+
+    resume() {
+        if (this.drainState) this._finishDrain(false);
+        this.isDraining = false;
+        return this;
+    }
+
+    _heldTasks() {
+        let held = 0;
+        for (const group of this.openGroups) held += group.held;
+        return held;
+    }
+
+    _checkDrained() {
+        if (this.activeTasks.size === 0 && this.taskQueue.length === 0 && this.parkedCount === 0 &&
+            this.completions.length === 0 && this.openGroups.size === 0) {
+            this._finishDrain(false);
+        }
+    }
+
+    _finishDrain(timedOut) {
+        const state = this.drainState;
+        if (!state) return;
+        this.drainState = null;
+        clearTimeout(state.timer);
+
+        const abandoned = this.activeTasks.size + this.taskQueue.length + this.parkedCount + this._heldTasks();
+        if (timedOut) {
+            // Batches stop submitting: their remaining tasks fail as drained
+            for (const group of this.openGroups) group.admitted = false;
+            this.openGroups.clear();
+            this._log('warn', `Drain timed out with ${abandoned} tasks pending`);
+            this._rejectAll('Drain timed out before the task finished');
+        }
+
+        const totals = this.metricsManager.shared.aggregate();
+        state.resolve({
+            pending: state.pending,
+            completed: totals.completed - state.baseCompleted,
+            failed: totals.failed - state.baseFailed,
+            abandoned: timedOut ? abandoned : 0,
+            timedOut,
+            durationMs: clock.now() - state.startTime
+        });
+    }
+
+    /**
+     * Error for a task the pool gave up on (terminate, drain) rather than one
+     * that failed: `aborted` tells batches not to journal it.
+     */
+    _abortError(message) {
+        const err = new Error(message);
+        err.aborted = true;
+        return err;
+    }
+
+    /**
+     * Rejects every queued and in-flight task. Workers running a rejected
+     * task are terminated so the abandoned work stops consuming CPU.
+     */
+    _rejectAll(message) {
+        // Callers may have dropped these promises when shutting down; marking
+        // them handled avoids unhandled rejections while awaiting callers
+        // still receive the error.
+        const abandon = (task) => {
+            if (task.bulkhead) this.bulkheadManager.release(task);
+            if (task.promise) task.promise.catch(() => { });
+            this._settle(task, this._abortError(message));
+        };
+
+        const queued = this.taskQueue;
+        this.taskQueue = [];
+        for (const task of queued) abandon(task);
+        for (const task of this._takeParked(() => true)) abandon(task);
+
+        const busyWorkers = new Set();
+        this.activeTasks.forEach((task) => {
+            busyWorkers.add(task.worker);
+            abandon(task);
+        });
+        this.activeTasks.clear();
+
+        this.workerPool = this.workerPool.filter(w => {
+            if (!busyWorkers.has(w.worker)) return true;
+            w.worker.terminate().catch(() => { });
+            return false;
+        });
+    }
+
     async terminate() {
         this.isTerminated = true;
         clearInterval(this.maintenanceInterval);
+        this._flushCompletions(); // Finished tasks still get their results
+        clearTimeout(this.wakeTimer);
+        this.wakeTimer = null;
+        if (this.drainState) this._finishDrain(false);
+        this._rejectAll('Tasklets instance was terminated');
         this.metricsManager.destroy();
+        this.affinityManager.destroy();
         await Promise.all(this.workerPool.map(w => w.worker.terminate()));
         this.workerPool = [];
     }
@@ -464,14 +2018,25 @@ const defaultPool = new Tasklets();
 
 // Static API for singleton usage (Ergonomics)
 Tasklets.run = defaultPool.run.bind(defaultPool);
+Tasklets.submit = defaultPool.submit.bind(defaultPool);
 Tasklets.runAll = defaultPool.runAll.bind(defaultPool);
+Tasklets.any = defaultPool.any.bind(defaultPool);
+Tasklets.find = defaultPool.find.bind(defaultPool);
+Tasklets.scan = defaultPool.scan.bind(defaultPool);
+Tasklets.bsp = defaultPool.bsp.bind(defaultPool);
+Tasklets.monteCarlo = defaultPool.monteCarlo.bind(defaultPool);
+Tasklets.matmul = defaultPool.matmul.bind(defaultPool);
 Tasklets.batch = defaultPool.batch.bind(defaultPool);
+Tasklets.resumeBatch = defaultPool.resumeBatch.bind(defaultPool);
 Tasklets.configure = defaultPool.configure.bind(defaultPool);
 Tasklets.enableAdaptiveMode = defaultPool.enableAdaptiveMode.bind(defaultPool);
 Tasklets.setWorkloadType = defaultPool.setWorkloadType.bind(defaultPool);
 Tasklets.retry = defaultPool.retry.bind(defaultPool);
+Tasklets.reloadModule = defaultPool.reloadModule.bind(defaultPool);
 Tasklets.getStats = defaultPool.getStats.bind(defaultPool);
 Tasklets.getHealth = defaultPool.getHealth.bind(defaultPool);
+Tasklets.drain = defaultPool.drain.bind(defaultPool);
+Tasklets.resume = defaultPool.resume.bind(defaultPool);
 Tasklets.terminate = defaultPool.terminate.bind(defaultPool);
 Tasklets.shutdown = defaultPool.shutdown.bind(defaultPool);
 
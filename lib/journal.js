@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file journal.js
+ * @brief Append-only checkpoint journal for resumable batch jobs
+ */
+
+const fs = require('fs');
+const v8 = require('v8');
+
+const JOURNAL_VERSION = 1;
+
+// Payloads go through the V8 serializer so the journal accepts exactly the
+// values postMessage can carry (typed arrays, Maps, Dates, undefined...).
+function encode(value) {
+    return v8.serialize(value).toString('base64');
+}
+
+function decode(data) {
+    return v8.deserialize(Buffer.from(data, 'base64'));
+}
+
+class BatchJournal {
+    constructor(filePath, options = {}) {
+        this.filePath = filePath;
+        this.syncEvery = options.syncEvery || 1000;
+        this.fd = null;
+        this.header = null;
+        this.entries = new Map(); // index -> { name, result, success, error }
+        this.unsynced = 0;
+    }
+
+    /**
+     * Starts a fresh journal for the given task descriptors, replacing any
+     * previous file at the same path.
+     */
+    static create(filePath, tasks, options = {}) {
+        const journal = new BatchJournal(filePath, options);
+        journal.header = {
+            type: 'header',
+            version: JOURNAL_VERSION,
+            total: tasks.length,
+            createdAt: Date.now(),
+            tasks: encode(tasks)
+        };
+        journal._writeHeader();
+        return journal;
+    }
+
+    /**
+     * Loads an existing journal. A torn final line (crash mid-write) is ignored.
+     */
+    static open(filePath, options = {}) {
+        const journal = new BatchJournal(filePath, options);
+        const content = fs.readFileSync(filePath);
+
+        // Records are newline-terminated; anything after the last newline is
+        // a torn write from a crash and is cut off before appending again.
+        const validLength = content.lastIndexOf(0x0a) + 1;
+        if (validLength < content.length) {
+            fs.truncateSync(filePath, validLength);
+        }
+
+        const lines = content.toString('utf8', 0, validLength).split('\n');
+        for (let i = 0; i < lines.length; i++) {
+            if (!lines[i]) continue;
+            let record;
+            try {
+                record = JSON.parse(lines[i]);
+            } catch (err) {
+                throw new Error(`Corrupt batch journal ${filePath} at line ${i + 1}`);
+            }
+
+            if (record.type === 'header') {
+                if (record.version !== JOURNAL_VERSION) {
+                    throw new Error(`Unsupported batch journal version ${record.version}`);
+                }
+                journal.header = record;
+            } else if (record.type === 'result') {
+                journal.entries.set(record.index, decode(record.data));
+            }
+        }
+
+        if (!journal.header) {
+            throw new Error(`Invalid batch journal ${filePath}: missing header`);
+        }
+
+        journal.fd = fs.openSync(filePath, 'a');
+        return journal;
+    }
+
+    get total() {
+        return this.header.total;
+    }
+
+    getTasks() {
+        return decode(this.header.tasks);
+    }
+
+    record(index, entry) {
+        this.entries.set(index, entry);
+        const line = JSON.stringify({ type: 'result', index, data: encode(entry) }) + '\n';
+        fs.writeSync(this.fd, line);
+
+        if (++this.unsynced >= this.syncEvery) {
+            this.sync();
+        }
+    }
+
+    /**
+     * Flushes appended records to disk. Every task index is recorded once,
+     * so the log never holds stale records and is not rewritten; a process
+     * crash loses nothing written, and a power loss at most the records
+     * since the last sync.
+     */
+    sync() {
+        if (this.fd !== null && this.unsynced > 0) {
+            fs.fdatasyncSync(this.fd);
+            this.unsynced = 0;
+        }
+    }
+
+    close() {
+        if (this.fd !== null) {
+            this.sync();
+            fs.closeSync(this.fd);
+            this.fd = null;
+        }
+    }
+
+    // The header is written beside any old file and renamed over it, so a
+    // crash leaves either the old or the new journal intact.
+    _writeHeader() {
+        const tmpPath = `${this.filePath}.tmp`;
+        const content = JSON.stringify(this.header) + '\n';
+
+        const tmpFd = fs.openSync(tmpPath, 'w');
+        try {
+            fs.writeSync(tmpFd, content);
+            fs.fsyncSync(tmpFd);
+        } finally {
+            fs.closeSync(tmpFd);
+        }
+
+        this.close();
+        fs.renameSync(tmpPath, this.filePath);
+        this.fd = fs.openSync(this.filePath, 'a');
+    }
+}
+
+module.exports = BatchJournal;
@@ -7,17 +7,20 @@
  */
 
 const os = require('os');
+const SharedMetrics = require('./shared-metrics');
 
 class MetricsManager {
     constructor() {
         this.totalTasks = 0;
-        this.processedTasks = 0;
-        this.totalExecutionTime = 0;
         this.startTime = Date.now();
 
-        // Rolling average window (last 100 tasks)
-        this.executionTimes = [];
-        this.windowSize = 100;
+        // Completions are recorded by the workers themselves into shared
+        // memory (see shared-metrics.js); nothing here runs per completion.
+        this.shared = new SharedMetrics();
+
+        // Rolling window: one aggregate snapshot per second, last 10 seconds
+        this.snapshots = [];
+        this.windowSize = 10;
 
         // Throughput tracking (last 1 second)
         this.lastProcessedCount = 0;
@@ -32,26 +35,62 @@ class MetricsManager {
         this.totalTasks++;
     }
 
-    recordTaskEnd(duration) {
-        this.processedTasks++;
-        this.totalExecutionTime += duration;
+    /**
+     * Hands out a shared metrics slot for a new worker (passed via workerData).
+     */
+    acquireWorkerSlot() {
+        return this.shared.acquire();
+    }
 
-        this.executionTimes.push(duration);
-        if (this.executionTimes.length > this.windowSize) {
-            this.executionTimes.shift();
-        }
+    releaseWorkerSlot(handle) {
+        this.shared.release(handle);
+    }
+
+    get processedTasks() {
+        const totals = this.shared.aggregate();
+        return totals.completed + totals.failed;
     }
 
     _calculateThroughput() {
-        const currentCount = this.processedTasks;
+        const totals = this.shared.aggregate();
+        const currentCount = totals.completed + totals.failed;
         this.throughput = currentCount - this.lastProcessedCount;
         this.lastProcessedCount = currentCount;
+
+        this.snapshots.push(totals);
+        if (this.snapshots.length > this.windowSize) {
+            this.snapshots.shift();
+        }
+    }
+
+    /**
+     * Averages over the rolling window, or over the whole lifetime when
+     * nothing completed inside the window.
+     */
+    _windowAverages(totals) {
+        const count = totals.completed + totals.failed;
+        let base = null;
+        for (const snapshot of this.snapshots) {
+            if (snapshot.completed + snapshot.failed < count) {
+                base = snapshot;
+                break;
+            }
+        }
+
+        const baseCount = base ? base.completed + base.failed : 0;
+        const tasks = count - baseCount;
+        const cpuSamples = totals.cpuSamples - (base ? base.cpuSamples : 0);
+        const wallNs = totals.wallNs - (base ? base.wallNs : 0n);
+        const cpuNs = totals.cpuNs - (base ? base.cpuNs : 0n);
+
+        return {
+            avgTaskTime: tasks > 0 ? Number(wallNs) / tasks / 1e6 : 0,
+            avgCpuTime: cpuSamples > 0 ? Number(cpuNs) / cpuSamples / 1e6 : null
+        };
     }
 
     getAverageExecutionTime() {
-        if (this.executionTimes.length === 0) return 0;
-        const sum = this.executionTimes.reduce((a, b) => a + b, 0);
-        return sum / this.executionTimes.length;
+        return this._windowAverages(this.shared.aggregate()).avgTaskTime;
     }
 
     getSystemMetrics() {
@@ -59,11 +98,23 @@ class MetricsManager {
         const freeMem = os.freemem();
         const memoryUsagePercent = ((totalMem - freeMem) / totalMem) * 100;
 
+        const totals = this.shared.aggregate();
+        const averages = this._windowAverages(totals);
+
         return {
             memoryUsagePercent,
             uptime: Math.floor((Date.now() - this.startTime) / 1000),
             throughput: this.throughput,
-            avgTaskTime: this.getAverageExecutionTime()
+            avgTaskTime: averages.avgTaskTime,
+            // null when no per-thread CPU clock is available (see clock.js)
+            avgCpuTime: averages.avgCpuTime,
+            processedTasks: totals.completed + totals.failed,
+            failedTasks: totals.failed,
+            taskTimePercentiles: {
+                p50: SharedMetrics.percentile(totals.histogram, 0.5),
+                p95: SharedMetrics.percentile(totals.histogram, 0.95),
+                p99: SharedMetrics.percentile(totals.histogram, 0.99)
+            }
         };
     }
 
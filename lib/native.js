@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file native.js
+ * @brief Loader for the optional native addon (native/)
+ *
+ * The addon is never required: it is only built by `npm run build:native`,
+ * and every caller must handle a `null` binding by falling back to JS.
+ */
+
+const path = require('path');
+
+const CANDIDATES = [
+    path.join(__dirname, '..', 'native', 'build', 'Release', 'tasklets_native.node'),
+    path.join(__dirname, '..', 'native', 'build', 'Debug', 'tasklets_native.node')
+];
+
+let binding;
+
+function load() {
+    if (binding !== undefined) return binding;
+    binding = null;
+
+    if (process.env.TASKLETS_DISABLE_NATIVE === '1') return binding;
+
+    for (const candidate of CANDIDATES) {
+        try {
+            binding = require(candidate);
+            break;
+        } catch (err) {
+            // Not built (or built for another ABI); try the next candidate.
+        }
+    }
+    return binding;
+}
+
+module.exports = { load };
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file ratelimit.js
+ * @brief Token-bucket rate limits per task type and per tenant
+ *
+ * A task needs one token from its type's bucket and one from its tenant's
+ * bucket (when either exists). Tasks without tokens are parked on the
+ * bucket that holds them; the scheduler asks `room()` how many can go and
+ * `wakeIn()` how long until more can.
+ */
+
+class TokenBucket {
+    constructor(limit, now) {
+        const opts = typeof limit === 'number' ? { rate: limit } : limit;
+        if (!(opts.rate > 0)) throw new Error('rateLimit rate must be a positive number of tasks per second');
+        this.rate = opts.rate;                       // tokens per second
+        this.burst = opts.burst || Math.max(1, opts.rate); // bucket capacity
+        this.tokens = this.burst;
+        this.last = now;
+        this.admitted = 0;
+        this.held = 0;
+    }
+
+    refill(now) {
+        if (now > this.last) {
+            this.tokens = Math.min(this.burst, this.tokens + (now - this.last) * this.rate / 1000);
+            this.last = now;
+        }
+    }
+
+    waitTime(now) {
+        this.refill(now);
+        return this.tokens >= 1 ? 0 : (1 - this.tokens) * 1000 / this.rate;
+    }
+}
+
+// Buckets made for '*' tenants are swept for idle ones whenever their count
+// doubles, so the sweep costs O(1) per tenant seen
+const MIN_SWEEP = 64;
+
+class RateLimitManager {
+    constructor(pool) {
+        this.pool = pool; // Reference to Tasklets instance
+        this.enabled = false;
+        this.typeBuckets = new Map();
+        this.tenantBuckets = new Map();
+        this.tenantDefault = null; // perTenant['*']: one bucket per tenant
+        this.sweepAt = MIN_SWEEP;
+    }
+
+    /**
+     * `{ perType: { [type]: limit }, perTenant: { [tenant | '*']: limit } }`
+     * where a limit is `rate` or `{ rate, burst }`. Reconfiguring replaces
+     * the buckets it names and keeps the others.
+     */
+    configure(options, now) {
+        if (!options) {
+            this.enabled = false;
+            this.typeBuckets.clear();
+            this.tenantBuckets.clear();
+            this.tenantDefault = null;
+            return;
+        }
+        for (const [type, limit] of Object.entries(options.perType || {})) {
+            this.typeBuckets.set(type, new TokenBucket(limit, now));
+        }
+        for (const [tenant, limit] of Object.entries(options.perTenant || {})) {
+            if (tenant === '*') {
+                new TokenBucket(limit, now); // validate
+                this.tenantDefault = limit;
+            } else {
+                this.tenantBuckets.set(tenant, new TokenBucket(limit, now));
+            }
+        }
+        this.enabled = this.typeBuckets.size > 0 || this.tenantBuckets.size > 0 || this.tenantDefault !== null;
+    }
+
+    /**
+     * Registers a limit given on the task itself. The first limit seen for a
+     * type wins, so per-call options cannot loosen a configured limit.
+     */
+    addTaskLimit(type, limit, now) {
+        if (!this.typeBuckets.has(type)) {
+            this.typeBuckets.set(type, new TokenBucket(limit, now));
+        }
+        this.enabled = true;
+    }
+
+    /**
+     * The bucket that keeps the task from starting now, or null.
+     */
+    heldBy(task, now) {
+        const typeBucket = this.typeBuckets.get(task.type);
+        const tenantBucket = this._tenantBucket(task.tenant, now);
+        let bucket = null;
+        if (typeBucket && typeBucket.waitTime(now) > 0) bucket = typeBucket;
+        else if (tenantBucket && tenantBucket.waitTime(now) > 0) bucket = tenantBucket;
+
+        if (bucket && !task.rateHeld) {
+            task.rateHeld = true;
+            if (typeBucket) typeBucket.held++;
+            if (tenantBucket) tenantBucket.held++;
+        }
+        return bucket;
+    }
+
+    /**
+     * How many tasks parked on `bucket` may be requeued now.
+     */
+    room(bucket, now) {
+        if (!this.enabled) return Infinity;
+        bucket.refill(now);
+        return Math.floor(bucket.tokens);
+    }
+
+    /**
+     * Milliseconds until `bucket` has a token again.
+     */
+    wakeIn(bucket, now) {
+        return bucket.waitTime(now);
+    }
+
+    take(task) {
+        const typeBucket = this.typeBuckets.get(task.type);
+        if (typeBucket) {
+            typeBucket.tokens--;
+            typeBucket.admitted++;
+        }
+        const tenantBucket = task.tenant !== undefined ? this.tenantBuckets.get(task.tenant) : null;
+        if (tenantBucket) {
+            tenantBucket.tokens--;
+            tenantBucket.admitted++;
+        }
+    }
+
+    /**
+     * Returns the tokens taken for a task that never reached a worker.
+     */
+    refund(task) {
+        const typeBucket = this.typeBuckets.get(task.type);
+        if (typeBucket) {
+            typeBucket.tokens = Math.min(typeBucket.burst, typeBucket.tokens + 1);
+            typeBucket.admitted--;
+        }
+        const tenantBucket = task.tenant !== undefined ? this.tenantBuckets.get(task.tenant) : null;
+        if (tenantBucket) {
+            tenantBucket.tokens = Math.min(tenantBucket.burst, tenantBucket.tokens + 1);
+            tenantBucket.admitted--;
+        }
+    }
+
+    getStats() {
+        const describe = (buckets) => {
+            const out = {};
+            for (const [key, b] of buckets) {
+                out[key] = { rate: b.rate, burst: b.burst, tokens: Math.floor(b.tokens), admitted: b.admitted, held: b.held };
+            }
+            return out;
+        };
+        return { types: describe(this.typeBuckets), tenants: describe(this.tenantBuckets) };
+    }
+
+    _tenantBucket(tenant, now) {
+        if (tenant === undefined) return null;
+        let bucket = this.tenantBuckets.get(tenant);
+        if (!bucket && this.tenantDefault !== null) {
+            if (this.tenantBuckets.size >= this.sweepAt) this._evictIdle(now);
+            bucket = new TokenBucket(this.tenantDefault, now);
+            bucket.evictable = true;
+            this.tenantBuckets.set(tenant, bucket);
+        }
+        return bucket || null;
+    }
+
+    /**
+     * Drops '*' tenant buckets that have refilled completely. A full bucket
+     * behaves exactly like a new one, so only its counters are lost.
+     */
+    _evictIdle(now) {
+        for (const [tenant, bucket] of this.tenantBuckets) {
+            if (!bucket.evictable) continue;
+            bucket.refill(now);
+            if (bucket.tokens >= bucket.burst) this.tenantBuckets.delete(tenant);
+        }
+        this.sweepAt = Math.max(MIN_SWEEP, this.tenantBuckets.size * 2);
+    }
+}
+
+module.exports = RateLimitManager;
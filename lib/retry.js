@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file retry.js
+ * @brief Retry policies, decorrelated-jitter backoff and retry budgets
+ */
+
+const BUCKET_MS = 1000;
+
+class RetryManager {
+    constructor(pool) {
+        this.pool = pool; // Reference to Tasklets instance
+
+        // Retry budget: retries may use at most `budget` x first attempts seen
+        // in the window, plus a small floor so low-traffic pools still retry.
+        this.budget = 0.2;
+        this.minRetriesPerWindow = 10;
+        this.windowMs = 10000;
+        this.buckets = []; // { start, requests, retries }
+        this.budgetConfigured = false; // retry() only spends a budget the user set up
+
+        this.typeStats = new Map();
+    }
+
+    configure(options = {}) {
+        if (options.budget !== undefined) this.budget = options.budget;
+        if (options.minRetriesPerWindow !== undefined) this.minRetriesPerWindow = options.minRetriesPerWindow;
+        if (options.windowMs !== undefined) this.windowMs = options.windowMs;
+        this.budgetConfigured = true;
+    }
+
+    /**
+     * Normalizes a task's `retry` option. `retry: 3` is shorthand for
+     * `{ attempts: 3 }`. Returns null when the task should not be retried.
+     */
+    static normalizePolicy(retry) {
+        if (!retry) return null;
+        const policy = typeof retry === 'number' ? { attempts: retry } : retry;
+        const attempts = policy.attempts || 3;
+        if (attempts < 2) return null;
+
+        const baseDelay = policy.baseDelay || 0;
+        return {
+            attempts,
+            baseDelay,
+            maxDelay: policy.maxDelay !== undefined ? policy.maxDelay : Math.max(baseDelay, 30000),
+            backoff: policy.backoff || 1,
+            jitter: policy.jitter !== false,
+            differentWorker: policy.differentWorker !== false,
+            budget: policy.budget !== false
+        };
+    }
+
+    /**
+     * Counts a first attempt of any task as traffic the budget is a share of.
+     */
+    recordRequest() {
+        this._bucket().requests++;
+    }
+
+    recordCall(task) {
+        this._stats(task.type).calls++;
+    }
+
+    recordSuccess(task) {
+        if (task.attempts > 1) this._stats(task.type).recovered++;
+    }
+
+    /**
+     * Decides whether a failed attempt is retried. On success returns the
+     * backoff delay in ms and charges the retry to the budget; otherwise
+     * returns -1.
+     */
+    nextDelay(task) {
+        const stats = this._stats(task.type);
+        if (task.attempts >= task.retry.attempts) {
+            stats.exhausted++;
+            return -1;
+        }
+        if (task.retry.budget && !this._withinBudget()) {
+            stats.budgetDenied++;
+            return -1;
+        }
+
+        this._bucket().retries++;
+        stats.retries++;
+
+        const { baseDelay, maxDelay, backoff, jitter } = task.retry;
+        if (!jitter) {
+            return Math.min(maxDelay, baseDelay * Math.pow(backoff, task.attempts - 1));
+        }
+
+        // Decorrelated jitter: sleep = min(cap, random(base, previous * 3)).
+        // Spreads retries from many callers instead of synchronizing them.
+        const previous = task.lastDelay || baseDelay;
+        const upper = Math.max(baseDelay, previous * 3);
+        const delay = Math.min(maxDelay, baseDelay + Math.random() * (upper - baseDelay));
+        task.lastDelay = delay;
+        return delay;
+    }
+
+    getStats() {
+        const { requests, retries } = this._windowTotals();
+        const types = {};
+        for (const [type, stats] of this.typeStats) types[type] = { ...stats };
+        return {
+            budget: this.budget,
+            window: { requests, retries },
+            types
+        };
+    }
+
+    _withinBudget() {
+        const { requests, retries } = this._windowTotals();
+        return retries < Math.max(this.minRetriesPerWindow, this.budget * requests);
+    }
+
+    _windowTotals() {
+        this._expire();
+        let requests = 0;
+        let retries = 0;
+        for (const b of this.buckets) {
+            requests += b.requests;
+            retries += b.retries;
+        }
+        return { requests, retries };
+    }
+
+    _bucket() {
+        const now = Date.now();
+        const last = this.buckets[this.buckets.length - 1];
+        if (last && now - last.start < BUCKET_MS) return last;
+        this._expire();
+        const bucket = { start: now, requests: 0, retries: 0 };
+        this.buckets.push(bucket);
+        return bucket;
+    }
+
+    _expire() {
+        const cutoff = Date.now() - this.windowMs;
+        while (this.buckets.length > 0 && this.buckets[0].start + BUCKET_MS <= cutoff) {
+            this.buckets.shift();
+        }
+    }
+
+    _stats(type) {
+        let stats = this.typeStats.get(type);
+        if (!stats) {
+            stats = { calls: 0, retries: 0, recovered: 0, exhausted: 0, budgetDenied: 0 };
+            this.typeStats.set(type, stats);
+        }
+        return stats;
+    }
+}
+
+module.exports = RetryManager;
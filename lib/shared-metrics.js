@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file shared-metrics.js
+ * @brief SharedArrayBuffer metrics area written by workers, read by the pool
+ *
+ * Each worker owns one slot and is its only writer, so recording a task is a
+ * handful of uncontended Atomics operations inside the worker. Slots are
+ * padded to whole cache lines so neighbouring workers never share one. The
+ * main thread only reads, and only when stats are requested.
+ */
+
+const SLOTS_PER_SEGMENT = 16;
+const SLOT_BYTES = 192;          // 3 x 64-byte cache lines
+const HISTOGRAM_BUCKETS = 32;    // bucket i counts tasks taking < 2^i microseconds
+
+// BigInt64 fields (index in 8-byte words from the slot start)
+const WALL_NS = 0;
+const CPU_NS = 1;
+// Int32 fields (index in 4-byte words from the slot start)
+const COMPLETED = 8;
+const FAILED = 9;
+const CPU_SAMPLES = 10;
+const HISTOGRAM = 11;            // 11 .. 42, ends at byte 172 < SLOT_BYTES
+
+function createSegment() {
+    const buffer = new SharedArrayBuffer(SLOTS_PER_SEGMENT * SLOT_BYTES);
+    return {
+        buffer,
+        i32: new Int32Array(buffer),
+        i64: new BigInt64Array(buffer),
+        used: new Array(SLOTS_PER_SEGMENT).fill(false)
+    };
+}
+
+/**
+ * Worker-side writer for a single slot.
+ */
+class MetricsSlot {
+    constructor(buffer, slot) {
+        this.i32 = new Int32Array(buffer, slot * SLOT_BYTES, SLOT_BYTES / 4);
+        this.i64 = new BigInt64Array(buffer, slot * SLOT_BYTES, SLOT_BYTES / 8);
+    }
+
+    record(wallMs, cpuMs, failed) {
+        const micros = wallMs * 1000;
+        const bucket = micros < 1 ? 0 : Math.min(HISTOGRAM_BUCKETS - 1, Math.floor(Math.log2(micros)) + 1);
+
+        Atomics.add(this.i64, WALL_NS, BigInt(Math.round(wallMs * 1e6)));
+        if (cpuMs !== null) {
+            Atomics.add(this.i64, CPU_NS, BigInt(Math.round(cpuMs * 1e6)));
+            Atomics.add(this.i32, CPU_SAMPLES, 1);
+        }
+        Atomics.add(this.i32, HISTOGRAM + bucket, 1);
+        // Counted last: a reader that sees the count also sees the timings.
+        Atomics.add(this.i32, failed ? FAILED : COMPLETED, 1);
+    }
+}
+
+/**
+ * Pool-side owner of all segments. Slots are recycled when workers exit but
+ * never cleared, so totals stay cumulative across worker turnover.
+ */
+class SharedMetrics {
+    constructor() {
+        this.segments = [];
+    }
+
+    acquire() {
+        for (const segment of this.segments) {
+            const slot = segment.used.indexOf(false);
+            if (slot !== -1) {
+                segment.used[slot] = true;
+                return { buffer: segment.buffer, slot };
+            }
+        }
+        const segment = createSegment();
+        this.segments.push(segment);
+        segment.used[0] = true;
+        return { buffer: segment.buffer, slot: 0 };
+    }
+
+    release(handle) {
+        if (!handle) return;
+        const segment = this.segments.find(s => s.buffer === handle.buffer);
+        if (segment) segment.used[handle.slot] = false;
+    }
+
+    /**
+     * Sums every slot. Counts are read before timings (the reverse of the
+     * write order) so totals never include a count without its timing.
+     */
+    aggregate() {
+        const totals = {
+            completed: 0,
+            failed: 0,
+            cpuSamples: 0,
+            wallNs: 0n,
+            cpuNs: 0n,
+            histogram: new Array(HISTOGRAM_BUCKETS).fill(0)
+        };
+
+        for (const segment of this.segments) {
+            for (let slot = 0; slot < SLOTS_PER_SEGMENT; slot++) {
+                const base32 = slot * (SLOT_BYTES / 4);
+                const base64 = slot * (SLOT_BYTES / 8);
+                totals.completed += Atomics.load(segment.i32, base32 + COMPLETED);
+                totals.failed += Atomics.load(segment.i32, base32 + FAILED);
+                totals.cpuSamples += Atomics.load(segment.i32, base32 + CPU_SAMPLES);
+                for (let b = 0; b < HISTOGRAM_BUCKETS; b++) {
+                    totals.histogram[b] += Atomics.load(segment.i32, base32 + HISTOGRAM + b);
+                }
+                totals.wallNs += Atomics.load(segment.i64, base64 + WALL_NS);
+                totals.cpuNs += Atomics.load(segment.i64, base64 + CPU_NS);
+            }
+        }
+        return totals;
+    }
+
+    /**
+     * Approximate percentile (ms) from the log2 histogram: the upper bound of
+     * the bucket holding the requested rank.
+     */
+    static percentile(histogram, p) {
+        const total = histogram.reduce((a, b) => a + b, 0);
+        if (total === 0) return 0;
+        const rank = Math.ceil(total * p);
+        let seen = 0;
+        for (let b = 0; b < histogram.length; b++) {
+            seen += histogram[b];
+            if (seen >= rank) return Math.pow(2, b) / 1000;
+        }
+        return Math.pow(2, histogram.length - 1) / 1000;
+    }
+}
+
+module.exports = SharedMetrics;
+module.exports.SharedMetrics = SharedMetrics;
+module.exports.MetricsSlot = MetricsSlot;
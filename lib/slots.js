@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file slots.js
+ * @brief Slot table for in-flight tasks with generation-tagged task IDs
+ *
+ * A task ID packs a slot index (low 20 bits) and the slot's generation
+ * (next 11 bits) into a small integer, so IDs stay Smis and a lookup is an
+ * array index plus one compare. Freed slots are reused LIFO; bumping the
+ * generation on release makes a late or duplicate result for the previous
+ * occupant miss instead of settling the wrong task.
+ */
+
+const INDEX_BITS = 20;
+const INDEX_MASK = (1 << INDEX_BITS) - 1;   // up to ~1M tasks in flight
+const GENERATION_MASK = (1 << 11) - 1;
+
+class TaskSlots {
+    constructor(initialCapacity = 256) {
+        this.records = new Array(initialCapacity).fill(null);
+        this.generations = new Uint16Array(initialCapacity);
+        this.free = new Int32Array(initialCapacity);
+        this.freeTop = 0;
+        this.capacity = 0; // Slots handed out at least once
+        this.size = 0;
+    }
+
+    /**
+     * Stores a record and returns its task ID.
+     */
+    acquire(record) {
+        let index;
+        if (this.freeTop > 0) {
+            index = this.free[--this.freeTop];
+        } else {
+            index = this.capacity++;
+            if (index > INDEX_MASK) throw new Error('Too many tasks in flight');
+            if (index >= this.records.length) this._grow();
+        }
+        this.records[index] = record;
+        this.size++;
+        return (this.generations[index] << INDEX_BITS) | index;
+    }
+
+    get(id) {
+        const index = id & INDEX_MASK;
+        if (index >= this.capacity || this.generations[index] !== (id >>> INDEX_BITS)) return undefined;
+        return this.records[index] || undefined;
+    }
+
+    release(id) {
+        const index = id & INDEX_MASK;
+        if (index >= this.capacity || this.generations[index] !== (id >>> INDEX_BITS) || !this.records[index]) return false;
+        this.records[index] = null;
+        this.generations[index] = (this.generations[index] + 1) & GENERATION_MASK;
+        this.free[this.freeTop++] = index;
+        this.size--;
+        return true;
+    }
+
+    /**
+     * Calls fn(record, id) for every occupied slot. Releasing slots from
+     * inside fn is allowed.
+     */
+    forEach(fn) {
+        for (let index = 0; index < this.capacity; index++) {
+            const record = this.records[index];
+            if (record) fn(record, (this.generations[index] << INDEX_BITS) | index);
+        }
+    }
+
+    clear() {
+        this.forEach((record, id) => this.release(id));
+    }
+
+    _grow() {
+        const length = this.records.length * 2;
+        const generations = new Uint16Array(length);
+        generations.set(this.generations);
+        const free = new Int32Array(length);
+        free.set(this.free);
+        for (let i = this.records.length; i < length; i++) this.records.push(null);
+        this.generations = generations;
+        this.free = free;
+    }
+}
+
+module.exports = TaskSlots;
@@ -7,6 +7,12 @@
  */
 
 const { parentPort, workerData } = require('worker_threads');
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const clock = require('./clock');
+const { MetricsSlot } = require('./shared-metrics');
 
 if (parentPort) {
   // Extract the secret token from workerData for authentication
@@ -16,68 +22,316 @@ if (parentPort) {
     throw new Error('Worker initialized without authentication secret');
   }
 
-  parentPort.on('message', async (message) => {
+  // Optional CPU pinning. Done from inside the thread so the addon can use the
+  // calling thread's TID directly.
+  if (workerData.cpu !== undefined && workerData.cpu !== null) {
+    const cpu = workerData.cpu;
+    let native = null;
     try {
-      // Validate authentication secret
-      if (!message || message.secret !== expectedSecret) {
-        throw new Error('Authentication failed: invalid or missing secret');
+      native = require('./native').load();
+      if (!native) throw new Error('native addon not available');
+      native.setAffinity([cpu]);
+      parentPort.postMessage({ type: 'affinity', cpu, tid: native.getTid() });
+    } catch (err) {
+      // The thread started with its creator's mask, which is a single CPU
+      // when the main thread is isolated: widen it to the workers' CPU set
+      try {
+        if (native && workerData.cpus) native.setAffinity(workerData.cpus);
+      } catch (resetErr) {
+        err.message += `; resetting to the worker CPU set also failed: ${resetErr.message}`;
       }
+      parentPort.postMessage({ type: 'affinity', cpu, error: err.message });
+    }
+  }
+
+  const metrics = workerData.metrics
+    ? new MetricsSlot(workerData.metrics.buffer, workerData.metrics.slot)
+    : null;
+
+  // Cooperative time slicing. Long tasks call `await tasklet.yield()` at
+  // checkpoints; once the current slice has used its quantum, the task is
+  // parked at the back of a round-robin queue and the event loop gets a turn,
+  // so other tasks on this worker (including newly received ones) can run.
+  let quantumMs = workerData.quantumMs || 10;
+  let sliceStart = clock.now();
+  const parked = []; // resolve, taskId, resolve, taskId, ...
+  let pumpScheduled = false;
+
+  // Cooperative cancellation (tasklets.any()). The pool stores the ID of a
+  // task to stop in a shared flag, which a task in a synchronous loop can
+  // poll, and also posts it, for tasks sharing this worker under time
+  // slicing. `currentTaskId` is the task whose code is running right now.
+  const cancelFlag = workerData.cancelFlag ? new Int32Array(workerData.cancelFlag) : null;
+  const runningTasks = new Set();
+  const cancelledTasks = new Set();
+  let currentTaskId = -1;
+  const isCancelled = () => currentTaskId !== -1 &&
+    ((cancelFlag !== null && Atomics.load(cancelFlag, 0) === currentTaskId) || cancelledTasks.has(currentTaskId));
+
+  const pump = () => {
+    pumpScheduled = false;
+    if (parked.length === 0) return;
+    const next = parked.shift();
+    currentTaskId = parked.shift();
+    sliceStart = clock.now();
+    next();
+    // Keep the rotation going even if the resumed task blocks on I/O
+    // instead of yielding again.
+    if (parked.length > 0) schedulePump();
+  };
+  const schedulePump = () => {
+    if (!pumpScheduled) {
+      pumpScheduled = true;
+      setImmediate(pump);
+    }
+  };
+
+  globalThis.tasklet = Object.freeze({
+    yield() {
+      if (clock.now() - sliceStart < quantumMs) return Promise.resolve();
+      const taskId = currentTaskId;
+      return new Promise(resolve => {
+        parked.push(resolve, taskId);
+        schedulePump();
+      });
+    },
+    get cancelled() {
+      return isCancelled();
+    },
+    throwIfCancelled() {
+      if (isCancelled()) throw new Error('Task cancelled');
+    }
+  });
+
+  // Module tasks (MODULE:/ESM:) resolve to a handler once per worker: the
+  // path is resolved, checked against the allowlist and loaded on first use,
+  // after which a task costs a single Map lookup. require.resolve() follows
+  // symlinks, so paths it can't resolve and allowlisted directories do too.
+  const realpath = (p) => {
+    try {
+      return fs.realpathSync(p);
+    } catch (err) {
+      return p;
+    }
+  };
 
-      if (!message.task) {
+  const resolveModulePath = (modulePath) => {
+    try {
+      return require.resolve(modulePath);
+    } catch (err) {
+      // Not resolvable from here (missing file, ESM-only package): compare
+      // and load it as given.
+      return path.isAbsolute(modulePath) || modulePath.startsWith('.') ? realpath(path.resolve(modulePath)) : modulePath;
+    }
+  };
+
+  // Allowlist entries are files, or directories that allow everything below them
+  const allowedModules = workerData && Array.isArray(workerData.allowedModules) ? workerData.allowedModules : null;
+  const allowedFiles = new Set();
+  const allowedDirs = [];
+  if (allowedModules) {
+    for (const entry of allowedModules) {
+      const resolved = resolveModulePath(entry);
+      allowedFiles.add(resolved);
+      if (path.isAbsolute(entry)) allowedDirs.push(realpath(path.resolve(entry)) + path.sep);
+    }
+  }
+
+  const checkAllowed = (modulePath) => {
+    const resolved = resolveModulePath(modulePath);
+    if (allowedModules && !allowedFiles.has(resolved) && !allowedDirs.some(dir => resolved.startsWith(dir))) {
+      throw new Error(`Module loading denied: ${modulePath} not in allowlist`);
+    }
+    return resolved;
+  };
+
+  // Splits 'path#export' into its parts ('#' inside a directory name is kept)
+  const parseSpecifier = (spec) => {
+    const hash = spec.lastIndexOf('#');
+    return hash === -1 || spec.includes('/', hash)
+      ? { modulePath: spec, exportName: null }
+      : { modulePath: spec.substring(0, hash), exportName: spec.substring(hash + 1) };
+  };
+
+  const handlers = new Map(); // 'MODULE:...' / 'ESM:...' / 'BUILTIN:...' task string -> function
+  const esmModules = new Map(); // resolved path -> Promise<namespace>
+  const esmVersions = new Map(); // resolved path -> reload count (import() cannot be uncached)
+
+  // reloadModule({ mode: 'invalidate' }): the next task re-reads the file
+  const invalidateModule = (modulePath) => {
+    const resolved = resolveModulePath(modulePath);
+    delete require.cache[resolved];
+    if (esmModules.delete(resolved)) {
+      esmVersions.set(resolved, (esmVersions.get(resolved) || 0) + 1);
+    }
+    handlers.clear();
+  };
+
+  const loadModuleTask = (taskString) => {
+    const { modulePath, exportName } = parseSpecifier(taskString.substring(7)); // Remove 'MODULE:'
+    const resolved = checkAllowed(modulePath);
+    const mod = require(resolved);
+
+    let handler = mod;
+    if (exportName) handler = mod[exportName];
+    else if (typeof mod !== 'function' && mod && typeof mod.default === 'function') handler = mod.default;
+    if (typeof handler !== 'function') {
+      throw new Error(`Module task ${modulePath} has no exported function '${exportName || 'module.exports'}'`);
+    }
+    handlers.set(taskString, handler);
+    return handler;
+  };
+
+  const loadEsmTask = async (taskString) => {
+    const { modulePath, exportName = null } = parseSpecifier(taskString.substring(4)); // Remove 'ESM:'
+    const resolved = checkAllowed(modulePath);
+
+    let pending = esmModules.get(resolved);
+    if (!pending) {
+      const version = esmVersions.get(resolved);
+      const url = path.isAbsolute(resolved) ? pathToFileURL(resolved).href : resolved;
+      pending = import(version ? `${url}?v=${version}` : url);
+      esmModules.set(resolved, pending);
+      // A failed import is not cached, so a fixed module can be retried
+      pending.catch(() => esmModules.delete(resolved));
+    }
+    const namespace = await pending;
+
+    const handler = namespace[exportName || 'default'];
+    if (typeof handler !== 'function') {
+      throw new Error(`ESM task ${modulePath} has no exported function '${exportName || 'default'}'`);
+    }
+    handlers.set(taskString, handler);
+    return handler;
+  };
+
+  // BUILTIN:name runs lib/builtins/name.js, the worker half of pool APIs
+  // such as find(). These ship with the library, so the allowlist does not
+  // apply.
+  const loadBuiltinTask = (taskString) => {
+    const name = taskString.substring(8); // Remove 'BUILTIN:'
+    if (!/^[a-z][a-z-]*$/.test(name)) throw new Error(`Unknown builtin task: ${name}`);
+    let handler;
+    try {
+      handler = require(path.join(__dirname, 'builtins', `${name}.js`));
+    } catch (err) {
+      if (err.code === 'MODULE_NOT_FOUND') throw new Error(`Unknown builtin task: ${name}`);
+      throw err;
+    }
+    handlers.set(taskString, handler);
+    return handler;
+  };
+
+  const recordTiming = (wallStart, cpuStart, failed) => {
+    if (wallStart === null) {
+      // Rejected before running (allowlist, bad task)
+      metrics.record(0, null, failed);
+      return;
+    }
+    const wall = clock.now() - wallStart;
+    const cpu = cpuStart !== null ? clock.threadCpuTime() - cpuStart : null;
+    metrics.record(wall, cpu, failed);
+  };
+
+  const startTask = (taskId) => {
+    runningTasks.add(taskId);
+    // A flag left over from a task that finished before it was read
+    if (cancelFlag !== null) {
+      const flagged = Atomics.load(cancelFlag, 0);
+      if (flagged !== -1 && !runningTasks.has(flagged)) Atomics.compareExchange(cancelFlag, 0, flagged, -1);
+    }
+  };
+
+  const finishTask = (taskId) => {
+    runningTasks.delete(taskId);
+    cancelledTasks.delete(taskId);
+    if (cancelFlag !== null) Atomics.compareExchange(cancelFlag, 0, taskId, -1);
+    if (currentTaskId === taskId) currentTaskId = -1;
+  };
+
+  // Reused for every successful result: postMessage clones synchronously
+  const reply = { taskId: 0, result: null, error: null };
+
+  const handleMessage = async (message) => {
+    if (message && message.type === 'timeSlicing') {
+      quantumMs = message.quantumMs;
+      return;
+    }
+    if (message && message.type === 'reload') {
+      invalidateModule(message.path);
+      return;
+    }
+    if (message && message.type === 'cancel') {
+      if (runningTasks.has(message.taskId)) cancelledTasks.add(message.taskId);
+      return;
+    }
+
+    let wallStart = null;
+    let cpuStart = null;
+
+    try {
+      if (!message || !message.task) {
         throw new Error('No task provided');
       }
+      startTask(message.taskId);
 
       // Deserialize function if it's a string
       // Note: This relies on the function being self-contained or using require()
       let taskFn;
       if (typeof message.task === 'string') {
-        if (message.task.startsWith('MODULE:')) {
-          const modulePath = message.task.substring(7); // Remove 'MODULE:'
-
-          // Enforce allowedModules if provided
-          const allowedModules = workerData && workerData.allowedModules;
-          if (allowedModules && Array.isArray(allowedModules)) {
-            if (!allowedModules.includes(modulePath)) {
-              throw new Error(`Module loading denied: ${modulePath} not in allowlist`);
-            }
+        taskFn = handlers.get(message.task);
+        if (!taskFn) {
+          if (message.task.startsWith('MODULE:')) {
+            taskFn = loadModuleTask(message.task);
+          } else if (message.task.startsWith('ESM:')) {
+            taskFn = await loadEsmTask(message.task);
+          } else if (message.task.startsWith('BUILTIN:')) {
+            taskFn = loadBuiltinTask(message.task);
+          } else {
+            // Wrap in parentheses to Ensure it's treated as an expression
+            taskFn = new Function(`return (${message.task})`)();
           }
-
-          taskFn = require(modulePath);
-        } else {
-          // Wrap in parentheses to Ensure it's treated as an expression
-          taskFn = new Function(`return (${message.task})`)();
         }
       } else {
         throw new Error('Task must be a stringified function');
       }
 
-      // Execute task
+      // Execute task, timing wall and thread CPU time around it
+      wallStart = clock.now();
+      sliceStart = wallStart;
+      cpuStart = clock.threadCpuTime ? clock.threadCpuTime() : null;
+      currentTaskId = message.taskId;
       const result = await taskFn(...(message.args || []));
+      finishTask(message.taskId);
 
       // Explicitly reject BigInt and Symbol for return values (required for some legacy tests)
       if (typeof result === 'bigint' || typeof result === 'symbol') {
         throw new Error(`Serialization of ${typeof result} is explicitly disabled in this environment`);
       }
 
+      if (metrics) recordTiming(wallStart, cpuStart, false);
+
       // Post result back
       try {
-        parentPort.postMessage({
-          taskId: message.taskId,
-          result: result,
-          error: null
-        });
+        reply.taskId = message.taskId;
+        reply.result = result;
+        taskPort.postMessage(reply);
       } catch (serializeError) {
         // Handle serialization errors (e.g., DataCloneError for BigInt or Symbol)
-        parentPort.postMessage({
+        taskPort.postMessage({
           taskId: message.taskId,
           result: null,
           error: `Serialization error: ${serializeError.message}`
         });
+      } finally {
+        reply.result = null;
       }
 
     } catch (error) {
+      if (message) finishTask(message.taskId);
+      if (metrics) recordTiming(wallStart, cpuStart, true);
       try {
-        parentPort.postMessage({
+        taskPort.postMessage({
           taskId: message ? message.taskId : null,
           result: null,
           error: (error && error.message) ? error.message : String(error),
@@ -85,12 +339,28 @@ if (parentPort) {
         });
       } catch (e) {
         // Absolute fallback if even the error object can't be sent
-        parentPort.postMessage({
+        taskPort.postMessage({
           taskId: message ? message.taskId : null,
           result: null,
           error: "Critical worker error"
         });
       }
     }
+  };
+
+  // One-time handshake. The pool's first message proves it holds the secret
+  // and hands over a private MessagePort; tasks are accepted only on that
+  // port from then on, so individual messages carry no credentials. Anything
+  // else posted to parentPort is ignored.
+  let taskPort = null;
+  const expected = Buffer.from(expectedSecret);
+  parentPort.on('message', (message) => {
+    if (taskPort) return;
+    const offered = Buffer.from(message && message.type === 'handshake' && typeof message.secret === 'string' ? message.secret : '');
+    if (offered.length !== expected.length || !crypto.timingSafeEqual(offered, expected) || !message.port) {
+      throw new Error('Authentication failed: invalid worker handshake');
+    }
+    taskPort = message.port;
+    taskPort.on('message', handleMessage);
   });
 }
@@ -0,0 +1,10 @@
+{
+  "targets": [
+    {
+      "target_name": "tasklets_native",
+      "sources": ["src/tasklets_native.c"],
+      "defines": ["NAPI_VERSION=8"],
+      "cflags": ["-O2", "-Wall"]
+    }
+  ]
+}
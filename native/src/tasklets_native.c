@@ -0,0 +1,250 @@
+/**
+ * Copyright (c) 2025 Jackson Wendel Santos Sá
+ * Licensed under the MIT License
+ *
+ * @file tasklets_native.c
+ * @brief Optional Node-API addon: CPU affinity and high-resolution clocks
+ *
+ * Every function acts on the calling thread unless a TID is passed, so a
+ * worker can pin itself (or read its own CPU clock) without the main thread
+ * knowing its TID.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <node_api.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <time.h>
+#define TASKLETS_HAVE_CLOCKS 1
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TASKLETS_HAVE_RDTSC 1
+#endif
+
+#define NAPI_CALL(env, call)                                              \
+  do {                                                                    \
+    if ((call) != napi_ok) {                                              \
+      const napi_extended_error_info* info = NULL;                        \
+      napi_get_last_error_info((env), &info);                             \
+      napi_throw_error((env), NULL,                                       \
+                       (info && info->error_message) ? info->error_message \
+                                                     : "Node-API call failed"); \
+      return NULL;                                                        \
+    }                                                                     \
+  } while (0)
+
+static napi_value throw_errno(napi_env env, const char* what) {
+  char msg[256];
+  snprintf(msg, sizeof(msg), "%s failed: %s", what, strerror(errno));
+  napi_throw_error(env, NULL, msg);
+  return NULL;
+}
+
+#ifdef __linux__
+
+/* Reads an optional TID argument; 0 means the calling thread. */
+static int read_tid(napi_env env, napi_callback_info info, size_t index, pid_t* tid) {
+  size_t argc = 2;
+  napi_value argv[2];
+  napi_valuetype type;
+  int32_t value = 0;
+
+  *tid = 0;
+  if (napi_get_cb_info(env, info, &argc, argv, NULL, NULL) != napi_ok) return 0;
+  if (argc <= index) return 1;
+  if (napi_typeof(env, argv[index], &type) != napi_ok) return 0;
+  if (type == napi_undefined || type == napi_null) return 1;
+  if (type != napi_number || napi_get_value_int32(env, argv[index], &value) != napi_ok || value < 0) {
+    napi_throw_type_error(env, NULL, "tid must be a non-negative integer");
+    return 0;
+  }
+  *tid = (pid_t)value;
+  return 1;
+}
+
+static napi_value GetTid(napi_env env, napi_callback_info info) {
+  napi_value result;
+  NAPI_CALL(env, napi_create_int32(env, (int32_t)syscall(SYS_gettid), &result));
+  return result;
+}
+
+static napi_value GetCpu(napi_env env, napi_callback_info info) {
+  napi_value result;
+  int cpu = sched_getcpu();
+  if (cpu < 0) return throw_errno(env, "sched_getcpu");
+  NAPI_CALL(env, napi_create_int32(env, cpu, &result));
+  return result;
+}
+
+static napi_value SetAffinity(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  bool is_array = false;
+  uint32_t length = 0;
+  cpu_set_t set;
+  pid_t tid = 0;
+
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  if (argc < 1) {
+    napi_throw_type_error(env, NULL, "setAffinity(cpus[, tid]) requires a CPU list");
+    return NULL;
+  }
+  NAPI_CALL(env, napi_is_array(env, argv[0], &is_array));
+  if (!is_array) {
+    napi_throw_type_error(env, NULL, "cpus must be an array of CPU indices");
+    return NULL;
+  }
+  if (!read_tid(env, info, 1, &tid)) return NULL;
+
+  CPU_ZERO(&set);
+  NAPI_CALL(env, napi_get_array_length(env, argv[0], &length));
+  for (uint32_t i = 0; i < length; i++) {
+    napi_value element;
+    int32_t cpu = -1;
+    NAPI_CALL(env, napi_get_element(env, argv[0], i, &element));
+    if (napi_get_value_int32(env, element, &cpu) != napi_ok || cpu < 0 || cpu >= CPU_SETSIZE) {
+      napi_throw_range_error(env, NULL, "CPU index out of range");
+      return NULL;
+    }
+    CPU_SET(cpu, &set);
+  }
+  if (CPU_COUNT(&set) == 0) {
+    napi_throw_range_error(env, NULL, "cpus must contain at least one CPU");
+    return NULL;
+  }
+
+  if (sched_setaffinity(tid, sizeof(set), &set) != 0) return throw_errno(env, "sched_setaffinity");
+  return NULL;
+}
+
+static napi_value GetAffinity(napi_env env, napi_callback_info info) {
+  cpu_set_t set;
+  pid_t tid = 0;
+  napi_value result;
+  uint32_t n = 0;
+
+  if (!read_tid(env, info, 0, &tid)) return NULL;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(tid, sizeof(set), &set) != 0) return throw_errno(env, "sched_getaffinity");
+
+  NAPI_CALL(env, napi_create_array(env, &result));
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &set)) {
+      napi_value value;
+      NAPI_CALL(env, napi_create_int32(env, cpu, &value));
+      NAPI_CALL(env, napi_set_element(env, result, n++, value));
+    }
+  }
+  return result;
+}
+
+#else /* !__linux__ */
+
+static napi_value Unsupported(napi_env env, napi_callback_info info) {
+  napi_throw_error(env, NULL, "CPU affinity is only supported on Linux");
+  return NULL;
+}
+
+#define GetTid Unsupported
+#define GetCpu Unsupported
+#define SetAffinity Unsupported
+#define GetAffinity Unsupported
+
+#endif
+
+#ifdef TASKLETS_HAVE_CLOCKS
+
+/* Milliseconds as a double: ~0.1ns of precision left for uptimes of weeks. */
+static napi_value read_clock_ms(napi_env env, clockid_t clock, const char* what) {
+  struct timespec ts;
+  napi_value result;
+  if (clock_gettime(clock, &ts) != 0) return throw_errno(env, what);
+  NAPI_CALL(env, napi_create_double(env, (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6, &result));
+  return result;
+}
+
+/* CLOCK_MONOTONIC is system-wide, so readings compare across threads. */
+static napi_value Now(napi_env env, napi_callback_info info) {
+  return read_clock_ms(env, CLOCK_MONOTONIC, "clock_gettime(CLOCK_MONOTONIC)");
+}
+
+static napi_value ThreadCpuTime(napi_env env, napi_callback_info info) {
+  return read_clock_ms(env, CLOCK_THREAD_CPUTIME_ID, "clock_gettime(CLOCK_THREAD_CPUTIME_ID)");
+}
+
+#else
+
+static napi_value ClocksUnsupported(napi_env env, napi_callback_info info) {
+  napi_throw_error(env, NULL, "Native clocks are not supported on this platform");
+  return NULL;
+}
+
+#define Now ClocksUnsupported
+#define ThreadCpuTime ClocksUnsupported
+
+#endif
+
+#ifdef TASKLETS_HAVE_RDTSC
+static napi_value Rdtsc(napi_env env, napi_callback_info info) {
+  napi_value result;
+  NAPI_CALL(env, napi_create_bigint_uint64(env, (uint64_t)__rdtsc(), &result));
+  return result;
+}
+#else
+static napi_value Rdtsc(napi_env env, napi_callback_info info) {
+  napi_throw_error(env, NULL, "rdtsc is only available on x86");
+  return NULL;
+}
+#endif
+
+static void set_flag(napi_env env, napi_value exports, const char* name, bool value) {
+  napi_value flag;
+  napi_get_boolean(env, value, &flag);
+  napi_set_named_property(env, exports, name, flag);
+}
+
+NAPI_MODULE_INIT() {
+  napi_property_descriptor props[] = {
+    { "getTid", NULL, GetTid, NULL, NULL, NULL, napi_enumerable, NULL },
+    { "getCpu", NULL, GetCpu, NULL, NULL, NULL, napi_enumerable, NULL },
+    { "setAffinity", NULL, SetAffinity, NULL, NULL, NULL, napi_enumerable, NULL },
+    { "getAffinity", NULL, GetAffinity, NULL, NULL, NULL, napi_enumerable, NULL },
+    { "now", NULL, Now, NULL, NULL, NULL, napi_enumerable, NULL },
+    { "threadCpuTime", NULL, ThreadCpuTime, NULL, NULL, NULL, napi_enumerable, NULL },
+    { "rdtsc", NULL, Rdtsc, NULL, NULL, NULL, napi_enumerable, NULL },
+  };
+
+  napi_define_properties(env, exports, sizeof(props) / sizeof(props[0]), props);
+
+#ifdef __linux__
+  set_flag(env, exports, "affinitySupported", true);
+#else
+  set_flag(env, exports, "affinitySupported", false);
+#endif
+#ifdef TASKLETS_HAVE_CLOCKS
+  set_flag(env, exports, "clocksSupported", true);
+#else
+  set_flag(env, exports, "clocksSupported", false);
+#endif
+#ifdef TASKLETS_HAVE_RDTSC
+  set_flag(env, exports, "rdtscSupported", true);
+#else
+  set_flag(env, exports, "rdtscSupported", false);
+#endif
+
+  return exports;
+}
@@ -0,0 +1,2 @@
+// Reports the CPU mask of the worker thread that runs it
+module.exports = () => require('../../lib/native').load().getAffinity();
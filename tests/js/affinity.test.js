@@ -0,0 +1,76 @@
+const Tasklets = require('../../lib/index');
+const path = require('path');
+const native = require('../../lib/native');
+
+const onLinux = process.platform === 'linux' ? test : test.skip;
+const withAddon = process.platform === 'linux' && native.load() ? test : test.skip;
+
+describe('CPU Affinity', () => {
+    let tasklets;
+
+    afterEach(async () => {
+        if (tasklets) {
+            await tasklets.shutdown();
+        }
+        jest.restoreAllMocks();
+    });
+
+    onLinux('should plan worker CPUs and isolate the main thread', () => {
+        const setAffinity = jest.fn();
+        jest.spyOn(native, 'load').mockReturnValue({
+            affinitySupported: true,
+            getAffinity: () => [0, 1, 2],
+            setAffinity
+        });
+
+        tasklets = new Tasklets({ logging: 'none' });
+        expect(tasklets.affinityManager.configure({ cpus: [0, 1, 2], isolateMainThread: true })).toBe(true);
+
+        expect(setAffinity).toHaveBeenCalledWith([0]);
+        expect(tasklets.getStats().config.affinity).toEqual({ cpus: [1, 2], mainCpu: 0 });
+
+        // Least-loaded CPU is picked for each new worker
+        tasklets.workerPool.push({ cpu: 1 });
+        expect(tasklets.affinityManager.assignCpu()).toBe(2);
+        tasklets.workerPool.push({ cpu: 2 });
+        tasklets.workerPool.push({ cpu: 2 });
+        expect(tasklets.affinityManager.assignCpu()).toBe(1);
+        tasklets.workerPool = [];
+
+        // Disabling restores the main thread's original CPU set
+        tasklets.configure({ affinity: false });
+        expect(setAffinity).toHaveBeenCalledWith([0, 1, 2]);
+        expect(tasklets.getStats().config.affinity).toBe(false);
+    });
+
+    test('should fall back to unpinned workers when the addon is missing', async () => {
+        jest.spyOn(native, 'load').mockReturnValue(null);
+
+        tasklets = new Tasklets({ logging: 'none', affinity: true });
+
+        expect(tasklets.getStats().config.affinity).toBe(false);
+        await expect(tasklets.run(() => 42)).resolves.toBe(42);
+    });
+
+    withAddon('should pin workers and report their thread ids', async () => {
+        tasklets = new Tasklets({ logging: 'none', maxWorkers: 1, affinity: true });
+
+        await tasklets.run(() => 1);
+        const workerObj = tasklets.workerPool[0];
+
+        expect(tasklets.getStats().config.affinity.cpus).toContain(workerObj.cpu);
+        expect(typeof workerObj.tid).toBe('number');
+        expect(workerObj.tid).toBeGreaterThan(0);
+    });
+
+    withAddon('should widen a worker to the worker CPU set when pinning fails', async () => {
+        const allowed = native.load().getAffinity();
+        // CPU 1000 is not online: the worker assigned to it cannot pin itself
+        tasklets = new Tasklets({ logging: 'none', maxWorkers: 1, affinity: { cpus: [1000, ...allowed] } });
+
+        const mask = await tasklets.run(`MODULE:${path.join(__dirname, 'affinity-module.cjs')}`);
+
+        expect(tasklets.workerPool[0].cpu).toBeUndefined();
+        expect(mask).toEqual(allowed);
+    });
+});
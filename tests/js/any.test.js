@@ -0,0 +1,111 @@
+const Tasklets = require('../../lib/index');
+
+const sleepThen = async (ms, value) => {
+    await new Promise(r => setTimeout(r, ms));
+    return value;
+};
+
+// Spins until cancelled, then records that it noticed: [runs, stopped]
+const spin = (gauge) => {
+    const view = new Int32Array(gauge);
+    Atomics.add(view, 0, 1);
+    const deadline = Date.now() + 5000;
+    while (!tasklet.cancelled && Date.now() < deadline);
+    if (tasklet.cancelled) Atomics.add(view, 1, 1);
+    tasklet.throwIfCancelled();
+    return 'finished';
+};
+
+const waitFor = async (predicate, timeoutMs = 2000) => {
+    const start = Date.now();
+    while (!predicate() && Date.now() - start < timeoutMs) {
+        await new Promise(r => setTimeout(r, 10));
+    }
+};
+
+describe('Scatter-Gather (any)', () => {
+    let tasklets;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 4, logging: 'none' });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should resolve with the first k successes in completion order', async () => {
+        const tasks = [[120, 'slow'], [10, 'fast'], [40, 'medium'], [200, 'slowest']]
+            .map(([ms, value]) => ({ task: sleepThen, args: [ms, value] }));
+
+        await expect(tasklets.any(tasks, { k: 2 })).resolves.toEqual(['fast', 'medium']);
+    });
+
+    test('should default to k = 1 and skip failures', async () => {
+        const tasks = [
+            () => { throw new Error('no luck'); },
+            { task: sleepThen, args: [30, 'found'] }
+        ];
+
+        await expect(tasklets.any(tasks)).resolves.toEqual(['found']);
+    });
+
+    test('should drop queued tasks once k results are in', async () => {
+        tasklets.configure({ maxWorkers: 1 });
+        const gauge = new SharedArrayBuffer(4);
+        const count = (g) => { Atomics.add(new Int32Array(g), 0, 1); return 'done'; };
+
+        const results = await tasklets.any(Array.from({ length: 6 }, () => ({ task: count, args: [gauge] })));
+
+        expect(results).toEqual(['done']);
+        expect(Atomics.load(new Int32Array(gauge), 0)).toBe(1);
+        expect(tasklets.getStats().queuedTasks).toBe(0);
+    });
+
+    test('should ask running tasks to stop', async () => {
+        const gauge = new SharedArrayBuffer(8);
+        const tasks = [
+            { task: spin, args: [gauge] },
+            { task: spin, args: [gauge] },
+            { task: sleepThen, args: [50, 'winner'] }
+        ];
+
+        await expect(tasklets.any(tasks)).resolves.toEqual(['winner']);
+        await waitFor(() => tasklets.getStats().activeTasks === 0);
+
+        const view = new Int32Array(gauge);
+        expect(Atomics.load(view, 0)).toBe(2);
+        expect(Atomics.load(view, 1)).toBe(2);
+        expect(tasklets.getStats().activeTasks).toBe(0);
+    });
+
+    test('should not flag tasks outside the scatter-gather call', async () => {
+        const outside = tasklets.run(async () => {
+            await new Promise(r => setTimeout(r, 100));
+            return tasklet.cancelled;
+        });
+        await tasklets.any([{ task: sleepThen, args: [10, 'x'] }, { task: sleepThen, args: [300, 'y'] }]);
+
+        await expect(outside).resolves.toBe(false);
+    });
+
+    test('should reject with an AggregateError when k cannot be reached', async () => {
+        const fail = (msg) => { throw new Error(msg); };
+        const tasks = [
+            { task: fail, args: ['a'] },
+            { task: sleepThen, args: [10, 'ok'] },
+            { task: fail, args: ['b'] }
+        ];
+
+        const err = await tasklets.any(tasks, { k: 2 }).catch(e => e);
+        expect(err).toBeInstanceOf(AggregateError);
+        expect(err.errors.map(e => e.message).sort()).toEqual(['a', 'b']);
+    });
+
+    test('should reject an invalid k', async () => {
+        await expect(tasklets.any([() => 1], { k: 2 }))
+            .rejects.toThrow('k must be an integer between 1 and the number of tasks');
+        await expect(tasklets.any([() => 1], { k: 0 }))
+            .rejects.toThrow('k must be an integer between 1 and the number of tasks');
+    });
+});
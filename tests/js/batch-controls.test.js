@@ -0,0 +1,114 @@
+const Tasklets = require('../../lib/index');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+// Counts runs and tracks how many copies run at once in shared memory:
+// [runs, current, max]
+const work = async (gauge, ms, fail) => {
+    const view = new Int32Array(gauge);
+    Atomics.add(view, 0, 1);
+    const current = Atomics.add(view, 1, 1) + 1;
+    let max = Atomics.load(view, 2);
+    while (current > max && Atomics.compareExchange(view, 2, max, current) !== max) {
+        max = Atomics.load(view, 2);
+    }
+    await new Promise(r => setTimeout(r, ms));
+    Atomics.sub(view, 1, 1);
+    if (fail) throw new Error('bad input');
+    return 'ok';
+};
+
+describe('Batch Concurrency & Fail-Fast', () => {
+    let tasklets;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 4, logging: 'none' });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('runAll should keep at most `concurrency` tasks in the pool', async () => {
+        const gauge = new SharedArrayBuffer(12);
+        const tasks = Array.from({ length: 10 }, () => ({ task: work, args: [gauge, 20] }));
+
+        const pending = tasklets.runAll(tasks, { concurrency: 2 });
+        await new Promise(r => setTimeout(r, 5));
+        const stats = tasklets.getStats();
+        expect(stats.activeTasks + stats.queuedTasks).toBeLessThanOrEqual(2);
+
+        expect(await pending).toEqual(Array(10).fill('ok'));
+        expect(Atomics.load(new Int32Array(gauge), 2)).toBe(2);
+    });
+
+    test('runAll should cancel the rest of the batch on the first failure', async () => {
+        tasklets.configure({ maxWorkers: 1 });
+        const gauge = new SharedArrayBuffer(12);
+        const tasks = [
+            { task: work, args: [gauge, 10, true] },
+            ...Array.from({ length: 5 }, () => ({ task: work, args: [gauge, 10] }))
+        ];
+
+        const results = await tasklets.runAll(tasks, { failFast: true });
+
+        expect(results[0].message).toBe('bad input');
+        for (const r of results.slice(1)) {
+            expect(r).toBeInstanceOf(Error);
+            expect(r.cancelled).toBe(true);
+        }
+        expect(Atomics.load(new Int32Array(gauge), 0)).toBe(1);
+        expect(tasklets.getStats().queuedTasks).toBe(0);
+    });
+
+    test('failFast should let tasks that are already running finish', async () => {
+        const gauge = new SharedArrayBuffer(12);
+        const tasks = [
+            { task: work, args: [gauge, 5, true] },
+            { task: work, args: [gauge, 50] },
+            { task: work, args: [gauge, 50] },
+            ...Array.from({ length: 4 }, () => ({ task: work, args: [gauge, 50] }))
+        ];
+
+        const results = await tasklets.runAll(tasks, { concurrency: 3, failFast: true });
+
+        expect(results.slice(1, 3)).toEqual(['ok', 'ok']);
+        expect(results.slice(3).every(r => r.cancelled)).toBe(true);
+        expect(Atomics.load(new Int32Array(gauge), 0)).toBe(3);
+    });
+
+    test('batch should mark cancelled entries and leave them out of the journal', async () => {
+        const tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'tasklets-failfast-'));
+        const journal = path.join(tmpDir, 'batch.journal');
+        try {
+            const tasks = [
+                { task: (x) => x, args: [1] },
+                { task: () => { throw new Error('broken'); } },
+                { task: (x) => x, args: [3] },
+                { task: (x) => x, args: [4] }
+            ];
+
+            const results = await tasklets.batch(tasks, { concurrency: 1, failFast: true, journal });
+
+            expect(results[0]).toEqual({ name: 'task-0', result: 1, success: true });
+            expect(results[1]).toEqual({ name: 'task-1', success: false, error: 'broken' });
+            expect(results[2]).toEqual(expect.objectContaining({ success: false, cancelled: true }));
+            expect(results[3].cancelled).toBe(true);
+
+            // Resuming re-runs only the cancelled tasks
+            const resumed = await tasklets.resumeBatch(journal);
+            expect(resumed.map(r => r.success)).toEqual([true, false, true, true]);
+            expect(resumed[3].result).toBe(4);
+        } finally {
+            fs.rmSync(tmpDir, { recursive: true, force: true });
+        }
+    });
+
+    test('should reject an invalid concurrency', async () => {
+        await expect(tasklets.runAll([() => 1], { concurrency: 0 }))
+            .rejects.toThrow('concurrency must be a positive integer');
+        await expect(tasklets.batch([() => 1], { concurrency: 1.5 }))
+            .rejects.toThrow('concurrency must be a positive integer');
+    });
+});
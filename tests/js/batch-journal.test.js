@@ -0,0 +1,128 @@
+const Tasklets = require('../../lib/index');
+const BatchJournal = require('../../lib/journal');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+describe('Checkpointed Batches', () => {
+    let tasklets;
+    let tmpDir;
+    let journalPath;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+        tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'tasklets-journal-'));
+        journalPath = path.join(tmpDir, 'batch.journal');
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+        fs.rmSync(tmpDir, { recursive: true, force: true });
+    });
+
+    test('should record every completion in the journal', async () => {
+        const tasks = [1, 2, 3, 4].map(n => ({ task: (x) => x * 10, args: [n] }));
+
+        const results = await tasklets.batch(tasks, { journal: journalPath });
+        expect(results.map(r => r.result)).toEqual([10, 20, 30, 40]);
+
+        const journal = BatchJournal.open(journalPath);
+        expect(journal.total).toBe(4);
+        expect(journal.entries.size).toBe(4);
+        expect(journal.entries.get(2)).toEqual({ name: 'task-2', result: 30, success: true });
+        journal.close();
+    });
+
+    test('should run tasks dropped by shutdown() again on resume', async () => {
+        const tasks = Array.from({ length: 8 }, (_, i) => ({
+            task: (n) => new Promise(resolve => setTimeout(() => resolve(n * 2), 80)),
+            args: [i]
+        }));
+
+        const interrupted = tasklets.batch(tasks, { journal: journalPath });
+        await new Promise(r => setTimeout(r, 120));
+        await tasklets.shutdown();
+        const partial = await interrupted;
+
+        const aborted = partial.filter(r => r.aborted);
+        expect(aborted.length).toBeGreaterThan(0);
+        const journal = BatchJournal.open(journalPath);
+        expect(journal.entries.size).toBe(8 - aborted.length);
+        journal.close();
+
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+        const results = await tasklets.resumeBatch(journalPath);
+
+        expect(results.map(r => r.result)).toEqual([0, 2, 4, 6, 8, 10, 12, 14]);
+        expect(tasklets.getStats().totalTasks).toBe(aborted.length);
+    });
+
+    test('should skip completed tasks when resuming', async () => {
+        const descriptors = [1, 2, 3].map(n => ({
+            name: `job-${n}`,
+            task: ((x) => x + 1).toString(),
+            args: [n]
+        }));
+
+        // Simulate a run that was interrupted after the first task finished
+        const journal = BatchJournal.create(journalPath, descriptors);
+        journal.record(0, { name: 'job-1', result: 'from-journal', success: true });
+        journal.close();
+
+        const progress = [];
+        const results = await tasklets.resumeBatch(journalPath, {
+            onProgress: (p) => progress.push(p.completed)
+        });
+
+        expect(results).toEqual([
+            { name: 'job-1', result: 'from-journal', success: true },
+            { name: 'job-2', result: 3, success: true },
+            { name: 'job-3', result: 4, success: true }
+        ]);
+        expect(Math.min(...progress)).toBe(2);
+        expect(tasklets.getStats().totalTasks).toBe(2);
+    });
+
+    test('should keep failures in the journal and not re-run them', async () => {
+        await tasklets.batch([
+            { task: () => { throw new Error('boom'); } },
+            { task: () => 'ok' }
+        ], { journal: journalPath });
+
+        const results = await tasklets.resumeBatch(journalPath);
+        expect(results[0]).toEqual({ name: 'task-0', success: false, error: 'boom' });
+        expect(results[1].result).toBe('ok');
+        expect(tasklets.getStats().totalTasks).toBe(2);
+    });
+
+    test('should append one record per completion without rewriting the journal', async () => {
+        const tasks = Array.from({ length: 10 }, (_, i) => ({ task: (x) => x, args: [i] }));
+        const sizes = [];
+
+        await tasklets.batch(tasks, {
+            journal: journalPath,
+            syncEvery: 4,
+            onProgress: () => sizes.push(fs.statSync(journalPath).size)
+        });
+
+        const lines = fs.readFileSync(journalPath, 'utf8').trim().split('\n');
+        expect(lines.map(l => JSON.parse(l).type)).toEqual(['header', ...new Array(10).fill('result')]);
+        expect(sizes.every((size, i) => i === 0 || size > sizes[i - 1])).toBe(true);
+
+        const results = await tasklets.resumeBatch(journalPath);
+        expect(results.map(r => r.result)).toEqual([0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);
+    });
+
+    test('should ignore a torn final record', async () => {
+        const journal = BatchJournal.create(journalPath, [{ name: 'a', task: '() => 1', args: [] }]);
+        journal.close();
+        fs.appendFileSync(journalPath, '{"type":"result","index":0,"da');
+
+        const results = await tasklets.resumeBatch(journalPath);
+        expect(results).toEqual([{ name: 'a', result: 1, success: true }]);
+    });
+
+    test('should reject resumeBatch without a valid path', async () => {
+        await expect(tasklets.resumeBatch(null)).rejects.toThrow('Journal path must be a string');
+    });
+});
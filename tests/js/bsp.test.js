@@ -0,0 +1,122 @@
+const Tasklets = require('../../lib/index');
+
+// 1-D three-point averaging stencil over two shared grids. Step s reads
+// grid s % 2 and writes the other, so neighbours' boundary cells are read
+// from the previous superstep; returns the largest change in the range.
+const smooth = (range, { step, shared }) => {
+    const src = new Float64Array(shared[step % 2]);
+    const dst = new Float64Array(shared[(step + 1) % 2]);
+    let change = 0;
+    for (let i = range.start; i < range.end; i++) {
+        if (i === 0 || i === src.length - 1) {
+            dst[i] = src[i];
+            continue;
+        }
+        dst[i] = (src[i - 1] + src[i] + src[i + 1]) / 3;
+        change = Math.max(change, Math.abs(dst[i] - src[i]));
+    }
+    return change;
+};
+
+const grids = (size) => {
+    const shared = [new SharedArrayBuffer(size * 8), new SharedArrayBuffer(size * 8)];
+    const first = new Float64Array(shared[0]);
+    for (let i = 0; i < size; i++) first[i] = i % 7 === 0 ? 100 : 0;
+    return shared;
+};
+
+const ranges = (size, parts) => Array.from({ length: parts }, (_, p) => ({
+    start: Math.floor(p * size / parts),
+    end: Math.floor((p + 1) * size / parts)
+}));
+
+describe('Bulk-Synchronous Runs (bsp)', () => {
+    let tasklets;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 4, logging: 'none' });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should exchange boundaries through shared memory between supersteps', async () => {
+        const size = 1001;
+        const shared = grids(size);
+        // Serial reference on private copies, computed before the run
+        const reference = [new Float64Array(shared[0]).slice(), new Float64Array(size)];
+        for (let step = 0; step < 20; step++) smooth({ start: 0, end: size }, { step, shared: reference.map(a => a.buffer) });
+        expect(reference[0]).not.toEqual(new Float64Array(shared[0]));
+
+        const result = await tasklets.bsp(ranges(size, 4), smooth, { shared, maxSteps: 20 });
+
+        expect(result.steps).toBe(20);
+        expect(result.aggregates).toHaveLength(4);
+        expect(new Float64Array(shared[0])).toEqual(reference[0]);
+    });
+
+    test('should stop when until() returns true', async () => {
+        const seen = [];
+        const result = await tasklets.bsp(ranges(40, 3), smooth, {
+            shared: grids(40),
+            maxSteps: 10000,
+            until: (changes, step) => {
+                seen.push(step);
+                return Math.max(...changes) < 1e-2;
+            }
+        });
+
+        expect(result.steps).toBeLessThan(10000);
+        expect(seen).toEqual(Array.from({ length: result.steps }, (_, i) => i));
+        expect(Math.max(...result.aggregates)).toBeLessThan(1e-2);
+    });
+
+    test('should keep each partition in its worker and return it with collect', async () => {
+        const step = (partition, ctx) => {
+            partition.visits.push(ctx.step);
+            return [ctx.index, partition.visits.length];
+        };
+
+        const result = await tasklets.bsp([{ visits: [] }, { visits: [] }], step, { maxSteps: 3, aggregateSize: 2, collect: true });
+
+        expect(result.partitions).toEqual([{ visits: [0, 1, 2] }, { visits: [0, 1, 2] }]);
+        expect(result.aggregates.map(a => Array.from(a))).toEqual([[0, 3], [1, 3]]);
+    });
+
+    test('should reject when a step throws and release every worker', async () => {
+        const step = (partition, ctx) => {
+            if (ctx.step === 2 && ctx.index === 1) throw new Error('diverged');
+            return 0;
+        };
+
+        await expect(tasklets.bsp([1, 2, 3], step, { maxSteps: 10 })).rejects.toThrow('diverged');
+        await expect(tasklets.runAll([() => 1, () => 2, () => 3, () => 4])).resolves.toEqual([1, 2, 3, 4]);
+        expect(tasklets.getStats().activeTasks).toBe(0);
+    });
+
+    test('should reject more partitions than workers and oversized aggregates', async () => {
+        await expect(tasklets.bsp([1, 2, 3, 4, 5], () => 0)).rejects.toThrow('5 partitions, 4 workers available');
+        await expect(tasklets.bsp([1], () => [1, 2], { maxSteps: 1 })).rejects.toThrow('aggregateSize is 1');
+    });
+
+    test('should count only the workers it can actually get', async () => {
+        await tasklets.run(() => 1); // one live worker
+        tasklets.configure({ maxMemory: 1 }); // no more spawns
+
+        await expect(tasklets.bsp([[1], [2]], (p) => p[0])).rejects.toThrow('2 partitions, 1 workers available');
+    });
+
+    test('should give up and release its workers when not every partition starts', async () => {
+        tasklets.configure({ maxWorkers: 2 });
+        const busy = tasklets.run(() => new Promise(r => setTimeout(() => r('done'), 800)));
+
+        const start = Date.now();
+        await expect(tasklets.bsp([1, 2], () => 0, { startTimeoutMs: 100 }))
+            .rejects.toThrow('could not start all partitions: 1 of 2 running after 100ms');
+        expect(Date.now() - start).toBeLessThan(600);
+
+        await expect(tasklets.run(() => 'free')).resolves.toBe('free');
+        await expect(busy).resolves.toBe('done');
+    });
+});
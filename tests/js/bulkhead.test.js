@@ -0,0 +1,84 @@
+const Tasklets = require('../../lib/index');
+
+// Tracks how many copies run at once in shared memory: [current, max]
+const render = async (gauge, ms) => {
+    const view = new Int32Array(gauge);
+    const current = Atomics.add(view, 0, 1) + 1;
+    let max = Atomics.load(view, 1);
+    while (current > max && Atomics.compareExchange(view, 1, max, current) !== max) {
+        max = Atomics.load(view, 1);
+    }
+    await new Promise(r => setTimeout(r, ms));
+    Atomics.sub(view, 0, 1);
+    return 'rendered';
+};
+
+describe('Bulkheads', () => {
+    let tasklets;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 3, logging: 'none', bulkheads: { render: 1 } });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should cap concurrency of a task type', async () => {
+        const gauge = new SharedArrayBuffer(8);
+
+        await Promise.all([1, 2, 3].map(() => tasklets.run(render, gauge, 50)));
+
+        expect(Atomics.load(new Int32Array(gauge), 1)).toBe(1);
+        const stats = tasklets.getStats().bulkheads.render;
+        expect(stats).toEqual(expect.objectContaining({ maxConcurrency: 1, active: 0, peak: 1, admitted: 3, held: 2 }));
+    });
+
+    test('should let other task types run while a bulkhead is full', async () => {
+        const gauge = new SharedArrayBuffer(8);
+        const renders = [1, 2, 3].map(() => tasklets.run(render, gauge, 150));
+
+        const start = Date.now();
+        await expect(tasklets.run(() => 'quick')).resolves.toBe('quick');
+        expect(Date.now() - start).toBeLessThan(140);
+        expect(tasklets.getStats().bulkheads.render.utilization).toBe(1);
+
+        await Promise.all(renders);
+    });
+
+    test('should accept maxConcurrency on the task descriptor', async () => {
+        const gauge = new SharedArrayBuffer(8);
+        const task = { task: render, args: [gauge, 30], name: 'pdf', maxConcurrency: 2 };
+
+        await Promise.all([1, 2, 3, 4].map(() => tasklets.run(task)));
+
+        expect(Atomics.load(new Int32Array(gauge), 1)).toBe(2);
+        expect(tasklets.getStats().bulkheads.pdf.peak).toBe(2);
+    });
+
+    test('should release the slot when a task fails', async () => {
+        await expect(tasklets.run({ task: () => { throw new Error('bad page'); }, name: 'render' }))
+            .rejects.toThrow('bad page');
+        expect(tasklets.getStats().bulkheads.render.active).toBe(0);
+        await expect(tasklets.run(render, new SharedArrayBuffer(8), 1)).resolves.toBe('rendered');
+    });
+
+    test('should count and cancel tasks waiting on a full bulkhead', async () => {
+        const gauge = new SharedArrayBuffer(8);
+        const tasks = Array.from({ length: 20 }, () => ({ task: render, name: 'render', args: [gauge, 100] }));
+        tasks.push({ task: () => { throw new Error('bad page'); }, name: 'fail', args: [] });
+
+        const batch = tasklets.runAll(tasks, { failFast: true });
+        expect(tasklets.getStats().queuedTasks).toBe(19);
+
+        const results = await batch;
+        expect(results.filter(r => r === 'rendered').length).toBe(1);
+        expect(results.filter(r => r instanceof Error && r.cancelled).length).toBe(19);
+        expect(tasklets.getStats().queuedTasks).toBe(0);
+    });
+
+    test('should reject an invalid maxConcurrency', async () => {
+        await expect(tasklets.run({ task: () => 1, maxConcurrency: 0 }))
+            .rejects.toThrow('maxConcurrency must be a positive integer');
+    });
+});
@@ -0,0 +1,129 @@
+const Tasklets = require('../../lib/index');
+
+// Fails while the flag in shared memory is set
+const guarded = (flag) => {
+    if (Atomics.load(new Int32Array(flag), 0) === 1) throw new Error('downstream broken');
+    return 'ok';
+};
+
+describe('Circuit Breakers', () => {
+    let tasklets;
+    let flag;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({
+            maxWorkers: 2,
+            logging: 'none',
+            circuitBreaker: { failureThreshold: 0.5, minRequests: 4, openMs: 100 }
+        });
+        flag = new SharedArrayBuffer(4);
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    const breakDownstream = () => Atomics.store(new Int32Array(flag), 0, 1);
+    const fixDownstream = () => Atomics.store(new Int32Array(flag), 0, 0);
+
+    const tripCircuit = async () => {
+        breakDownstream();
+        for (let i = 0; i < 4; i++) {
+            await expect(tasklets.run(guarded, flag)).rejects.toThrow('downstream broken');
+        }
+    };
+
+    test('should open after the failure rate crosses the threshold and fail fast', async () => {
+        const events = [];
+        tasklets.on('circuit:open', (info) => events.push(info));
+
+        await tripCircuit();
+
+        expect(events).toEqual([{ type: 'guarded' }]);
+        await expect(tasklets.run(guarded, flag)).rejects.toThrow('Circuit open for task type guarded');
+
+        const stats = tasklets.getStats().circuits.guarded;
+        expect(stats.state).toBe('open');
+        expect(stats.rejected).toBe(1);
+        expect(tasklets.getStats().totalTasks).toBe(4);
+    });
+
+    test('should not affect other task types', async () => {
+        await tripCircuit();
+        await expect(tasklets.run(() => 'other')).resolves.toBe('other');
+    });
+
+    test('should close again after a successful half-open probe', async () => {
+        const transitions = [];
+        tasklets.on('circuit:half-open', () => transitions.push('half-open'));
+        tasklets.on('circuit:close', () => transitions.push('close'));
+
+        await tripCircuit();
+        fixDownstream();
+        await new Promise(r => setTimeout(r, 150));
+
+        await expect(tasklets.run(guarded, flag)).resolves.toBe('ok');
+        expect(transitions).toEqual(['half-open', 'close']);
+        expect(tasklets.getStats().circuits.guarded.state).toBe('closed');
+    });
+
+    test('should re-open when the probe fails', async () => {
+        await tripCircuit();
+        await new Promise(r => setTimeout(r, 150));
+
+        await expect(tasklets.run(guarded, flag)).rejects.toThrow('downstream broken');
+        expect(tasklets.getStats().circuits.guarded).toEqual(expect.objectContaining({ state: 'open', opened: 2 }));
+    });
+
+    test('should free the probe slot when a probe cannot be dispatched', async () => {
+        await tripCircuit();
+        fixDownstream();
+        await new Promise(r => setTimeout(r, 150));
+
+        await expect(tasklets.run({ task: guarded, args: [flag, { f() { } }] })).rejects.toThrow();
+        await expect(tasklets.run(guarded, flag)).resolves.toBe('ok');
+        expect(tasklets.getStats().circuits.guarded.state).toBe('closed');
+    });
+
+    test('should reject queued tasks of an open circuit without dispatching them', async () => {
+        tasklets.configure({ maxWorkers: 1 });
+        breakDownstream();
+
+        const results = await Promise.allSettled(Array.from({ length: 10 }, () => tasklets.run(guarded, flag)));
+
+        const circuitRejections = results.filter(r => r.reason && r.reason.message.startsWith('Circuit open'));
+        expect(circuitRejections).toHaveLength(6);
+        expect(tasklets.getStats().totalTasks).toBe(4);
+    });
+
+    test('should not open a shared circuit for unnamed inline tasks', async () => {
+        for (let i = 0; i < 6; i++) {
+            await expect(tasklets.run(() => { throw new Error('inline bug'); })).rejects.toThrow('inline bug');
+        }
+
+        await expect(tasklets.run((a, b) => a + b, 1, 2)).resolves.toBe(3);
+        expect(tasklets.getStats().circuits).toEqual({});
+    });
+
+    test('should not count builtin tasks against a shared circuit', async () => {
+        const chunks = [[1, 2], [3, 4]];
+        for (let i = 0; i < 4; i++) {
+            await expect(tasklets.find(chunks, () => { throw new Error('bad predicate'); })).rejects.toThrow('bad predicate');
+        }
+
+        await expect(tasklets.find(chunks, (x) => x === 3)).resolves.toEqual({ chunk: 1, index: 0, value: 3 });
+        expect(tasklets.getStats().circuits).toEqual({});
+    });
+
+    test('should be disabled by default', async () => {
+        const plain = new Tasklets({ maxWorkers: 1, logging: 'none' });
+        try {
+            for (let i = 0; i < 5; i++) {
+                await expect(plain.run(() => { throw new Error('boom'); })).rejects.toThrow('boom');
+            }
+            expect(plain.getStats().circuits).toEqual({});
+        } finally {
+            await plain.shutdown();
+        }
+    });
+});
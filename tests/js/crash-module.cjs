@@ -0,0 +1,10 @@
+const fs = require('fs');
+
+// Crashes the worker the first time it sees a given marker path, then succeeds.
+module.exports = (markerPath) => {
+    if (!fs.existsSync(markerPath)) {
+        fs.writeFileSync(markerPath, 'crashed');
+        process.exit(1);
+    }
+    return 'recovered';
+};
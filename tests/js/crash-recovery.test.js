@@ -0,0 +1,71 @@
+const Tasklets = require('../../lib/index');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+describe('Worker Crash Recovery', () => {
+    let tasklets;
+    let tmpDir;
+    const crashModule = `MODULE:${path.join(__dirname, 'crash-module.cjs')}`;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 2, minWorkers: 1, logging: 'none' });
+        tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'tasklets-crash-'));
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+        fs.rmSync(tmpDir, { recursive: true, force: true });
+    });
+
+    test('should transparently re-run idempotent tasks after a crash', async () => {
+        const requeued = [];
+        tasklets.on('task:requeued', (info) => requeued.push(info));
+
+        const result = await tasklets.run({
+            task: crashModule,
+            args: [path.join(tmpDir, 'marker')],
+            idempotent: true
+        });
+
+        expect(result).toBe('recovered');
+        expect(requeued).toEqual([{ type: crashModule, attempt: 2 }]);
+        expect(tasklets.getStats().recovery.requeued).toBe(1);
+    });
+
+    test('should reject non-idempotent tasks when their worker crashes', async () => {
+        await expect(tasklets.run(crashModule, path.join(tmpDir, 'marker')))
+            .rejects.toThrow('Worker exited unexpectedly with code 1');
+        expect(tasklets.getStats().recovery.requeued).toBe(0);
+    });
+
+    test('should stop retrying a poison task', async () => {
+        const poisoned = [];
+        tasklets.on('task:poisoned', (info) => poisoned.push(info));
+
+        await expect(tasklets.run({
+            name: 'killer',
+            task: () => process.exit(1),
+            idempotent: true,
+            maxAttempts: 2
+        })).rejects.toThrow('Poison task: killer crashed 2 workers');
+
+        expect(poisoned).toEqual([{ type: 'killer', crashes: 2 }]);
+        expect(tasklets.getStats().recovery).toEqual({ requeued: 1, poisoned: 1 });
+    });
+
+    test('should spawn a replacement worker after a crash', async () => {
+        await expect(tasklets.run(() => process.exit(1))).rejects.toThrow();
+
+        expect(tasklets.getStats().totalWorkers).toBe(1);
+        await expect(tasklets.run(() => 'still alive')).resolves.toBe('still alive');
+    });
+
+    test('should keep other tasks on their own workers unaffected', async () => {
+        const slow = tasklets.run(() => new Promise(r => setTimeout(() => r('slow done'), 200)));
+        const crash = tasklets.run(() => process.exit(1));
+
+        await expect(crash).rejects.toThrow();
+        await expect(slow).resolves.toBe('slow done');
+    });
+});
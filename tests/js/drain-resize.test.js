@@ -0,0 +1,123 @@
+const Tasklets = require('../../lib/index');
+
+const sleepTask = (ms, value) => new Promise(resolve => setTimeout(() => resolve(value), ms));
+
+describe('Graceful Drain and Pool Resize', () => {
+    let tasklets;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    describe('drain()', () => {
+        test('should finish in-flight and queued work before resolving', async () => {
+            const promises = [1, 2, 3].map(n => tasklets.run(sleepTask, 100, n));
+
+            const summary = await tasklets.drain();
+
+            await expect(Promise.all(promises)).resolves.toEqual([1, 2, 3]);
+            expect(summary).toEqual(expect.objectContaining({
+                pending: 3,
+                completed: 3,
+                failed: 0,
+                abandoned: 0,
+                timedOut: false
+            }));
+            expect(summary.durationMs).toBeGreaterThan(0);
+        });
+
+        test('should stop admission while draining', async () => {
+            tasklets.run(sleepTask, 50, 'x');
+            const drained = tasklets.drain();
+
+            await expect(tasklets.run(() => 1)).rejects.toThrow('Tasklets instance is draining');
+            await drained;
+
+            tasklets.resume();
+            await expect(tasklets.run(() => 'open again')).resolves.toBe('open again');
+        });
+
+        test('should abandon remaining work after timeoutMs', async () => {
+            const slow = tasklets.run(sleepTask, 5000, 'never');
+
+            const summary = await tasklets.drain({ timeoutMs: 100 });
+
+            expect(summary.timedOut).toBe(true);
+            expect(summary.abandoned).toBe(1);
+            await expect(slow).rejects.toThrow('Drain timed out');
+            expect(tasklets.getStats().activeTasks).toBe(0);
+        });
+
+        test('should let a concurrency-limited batch started before the drain finish', async () => {
+            const tasks = Array.from({ length: 8 }, (_, i) => ({ task: sleepTask, args: [20, i] }));
+            const batch = tasklets.runAll(tasks, { concurrency: 2 });
+
+            const summary = await tasklets.drain();
+
+            await expect(batch).resolves.toEqual([0, 1, 2, 3, 4, 5, 6, 7]);
+            expect(summary).toEqual(expect.objectContaining({ pending: 8, completed: 8, failed: 0, abandoned: 0 }));
+            const [late] = await tasklets.runAll([() => 1], { concurrency: 1 });
+            expect(late.message).toBe('Tasklets instance is draining');
+        });
+
+        test('should stop a held batch when the drain times out', async () => {
+            const tasks = Array.from({ length: 6 }, (_, i) => ({ task: sleepTask, args: [200, i] }));
+            const batch = tasklets.runAll(tasks, { concurrency: 1 });
+
+            const summary = await tasklets.drain({ timeoutMs: 50 });
+
+            expect(summary.abandoned).toBe(6);
+            const results = await batch;
+            expect(results.every(r => r instanceof Error)).toBe(true);
+        });
+
+        test('should resolve immediately when idle', async () => {
+            const summary = await tasklets.drain();
+            expect(summary.pending).toBe(0);
+        });
+    });
+
+    describe('live resize', () => {
+        test('should retire busy surplus workers only after their task finishes', async () => {
+            tasklets.configure({ maxWorkers: 3 });
+            const promises = [1, 2, 3].map(n => tasklets.run(sleepTask, 150, n));
+            expect(tasklets.getStats().totalWorkers).toBe(3);
+
+            tasklets.configure({ maxWorkers: 1 });
+            expect(tasklets.getStats().totalWorkers).toBe(3);
+
+            await expect(Promise.all(promises)).resolves.toEqual([1, 2, 3]);
+            expect(tasklets.getStats().totalWorkers).toBe(1);
+        });
+
+        test('should remove idle surplus workers immediately', async () => {
+            await tasklets.runAll([{ task: sleepTask, args: [50] }, { task: sleepTask, args: [50] }]);
+            expect(tasklets.getStats().totalWorkers).toBe(2);
+
+            tasklets.configure({ maxWorkers: 1 });
+            expect(tasklets.getStats().totalWorkers).toBe(1);
+        });
+
+        test('should use added capacity for queued tasks right away', async () => {
+            tasklets.configure({ maxWorkers: 1 });
+            const promises = [1, 2, 3].map(n => tasklets.run(sleepTask, 100, n));
+            expect(tasklets.getStats().queuedTasks).toBe(2);
+
+            tasklets.configure({ maxWorkers: 3 });
+            expect(tasklets.getStats().queuedTasks).toBe(0);
+            await Promise.all(promises);
+        });
+    });
+
+    test('terminate() should reject in-flight tasks', async () => {
+        const pending = tasklets.run(sleepTask, 5000, 'never');
+        await new Promise(r => setTimeout(r, 20));
+
+        await tasklets.terminate();
+        await expect(pending).rejects.toThrow('Tasklets instance was terminated');
+    });
+});
@@ -0,0 +1,9 @@
+export default function add(a, b) {
+    return a + b;
+}
+
+export async function greet(name) {
+    return `hello ${name}`;
+}
+
+export const notAFunction = 42;
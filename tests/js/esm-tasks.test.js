@@ -0,0 +1,48 @@
+const Tasklets = require('../../lib/index');
+const path = require('path');
+
+describe('ESM: Task Modules', () => {
+    let tasklets;
+    const modulePath = path.join(__dirname, 'esm-module.mjs');
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should run the default export', async () => {
+        await expect(tasklets.run(`ESM:${modulePath}`, 2, 3)).resolves.toBe(5);
+    });
+
+    test('should run a named export', async () => {
+        await expect(tasklets.run(`ESM:${modulePath}#greet`, 'esm')).resolves.toBe('hello esm');
+    });
+
+    test('should reuse the imported module across tasks', async () => {
+        const results = await Promise.all(
+            Array.from({ length: 20 }, (_, i) => tasklets.run(`ESM:${modulePath}`, i, 1))
+        );
+        expect(results).toEqual(Array.from({ length: 20 }, (_, i) => i + 1));
+    });
+
+    test('should reject exports that are not functions', async () => {
+        await expect(tasklets.run(`ESM:${modulePath}#notAFunction`))
+            .rejects.toThrow("has no exported function 'notAFunction'");
+    });
+
+    test('should reject a module that cannot be imported', async () => {
+        await expect(tasklets.run(`ESM:${path.join(__dirname, 'missing.mjs')}`)).rejects.toThrow();
+    });
+
+    test('should enforce allowedModules', async () => {
+        const restricted = new Tasklets({ maxWorkers: 1, logging: 'none', allowedModules: ['/nowhere.mjs'] });
+        try {
+            await expect(restricted.run(`ESM:${modulePath}`, 1, 2)).rejects.toThrow('Module loading denied');
+        } finally {
+            await restricted.shutdown();
+        }
+    });
+});
@@ -0,0 +1,63 @@
+const Tasklets = require('../../lib/index');
+
+describe('Parallel Search (find)', () => {
+    let tasklets;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 4, logging: 'none' });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should return the chunk, index and value of a match', async () => {
+        const chunks = [0, 1, 2, 3].map(c => Array.from({ length: 1000 }, (_, i) => c * 1000 + i));
+
+        await expect(tasklets.find(chunks, (x) => x === 2345)).resolves.toEqual({ chunk: 2, index: 345, value: 2345 });
+    });
+
+    test('should resolve undefined when nothing matches', async () => {
+        const chunks = [new Int32Array([1, 2, 3]), new Int32Array([4, 5, 6])];
+
+        await expect(tasklets.find(chunks, (x) => x > 10)).resolves.toBeUndefined();
+    });
+
+    test('should stop the other scans as soon as one chunk matches', async () => {
+        await tasklets.runAll([() => 1, () => 1, () => 1, () => 1]); // warm up the workers
+        // ~1ms per element: a full scan of a chunk takes at least 300ms
+        const slowMatch = (x) => {
+            const end = Date.now() + 1;
+            while (Date.now() < end);
+            return x === 1;
+        };
+        const chunks = [[0, 0, 1], ...[1, 2, 3].map(() => new Array(300).fill(0))];
+
+        const start = Date.now();
+        const hit = await tasklets.find(chunks, slowMatch);
+        while (tasklets.getStats().activeTasks > 0 && Date.now() - start < 2000) {
+            await new Promise(r => setTimeout(r, 5));
+        }
+
+        expect(hit).toEqual({ chunk: 0, index: 2, value: 1 });
+        expect(tasklets.getStats().activeTasks).toBe(0);
+        expect(Date.now() - start).toBeLessThan(250);
+    });
+
+    test('should reject when the predicate throws', async () => {
+        const chunks = [[1, 2], [3, 4]];
+
+        await expect(tasklets.find(chunks, (x) => { if (x === 3) throw new Error('bad item'); return false; }))
+            .rejects.toThrow('bad item');
+    });
+
+    test('should validate its arguments', async () => {
+        await expect(tasklets.find('nope', () => true)).rejects.toThrow('Chunks must be an array');
+        await expect(tasklets.find([[1]], 42)).rejects.toThrow('Predicate must be a function or a string');
+    });
+
+    test('should refuse unknown builtin tasks', async () => {
+        await expect(tasklets.run('BUILTIN:../index')).rejects.toThrow('Unknown builtin task');
+        await expect(tasklets.run('BUILTIN:missing')).rejects.toThrow('Unknown builtin task: missing');
+    });
+});
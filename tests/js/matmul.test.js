@@ -0,0 +1,75 @@
+const Tasklets = require('../../lib/index');
+
+const matrix = (rows, cols, Type = Float64Array) => ({
+    rows,
+    cols,
+    data: Type.from({ length: rows * cols }, () => Math.random() * 2 - 1)
+});
+
+const naive = (A, B) => {
+    const c = new Float64Array(A.rows * B.cols);
+    for (let i = 0; i < A.rows; i++) {
+        for (let j = 0; j < B.cols; j++) {
+            let sum = 0;
+            for (let p = 0; p < A.cols; p++) sum += A.data[i * A.cols + p] * B.data[p * B.cols + j];
+            c[i * B.cols + j] = sum;
+        }
+    }
+    return c;
+};
+
+const maxError = (a, b) => a.reduce((max, v, i) => Math.max(max, Math.abs(v - b[i])), 0);
+
+describe('Matrix Multiplication (matmul)', () => {
+    let tasklets;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 4, logging: 'none' });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should match a naive product for sizes that do not divide into tiles', async () => {
+        // k and n cross the kernel's block sizes (128 and 256)
+        const A = matrix(67, 301);
+        const B = matrix(301, 263);
+
+        const C = await tasklets.matmul(A, B);
+
+        expect(C.rows).toBe(67);
+        expect(C.cols).toBe(263);
+        expect(C.data).toBeInstanceOf(Float64Array);
+        expect(C.data.buffer).toBeInstanceOf(SharedArrayBuffer);
+        expect(maxError(C.data, naive(A, B))).toBeLessThan(1e-9);
+    });
+
+    test('should multiply Float32Array matrices', async () => {
+        const A = matrix(40, 50, Float32Array);
+        const B = matrix(50, 30, Float32Array);
+
+        const C = await tasklets.matmul(A, B);
+
+        expect(C.data).toBeInstanceOf(Float32Array);
+        expect(maxError(C.data, naive(A, B))).toBeLessThan(1e-4);
+    });
+
+    test('should use shared inputs in place and accept its own result', async () => {
+        const I = { rows: 3, cols: 3, data: new Float64Array(new SharedArrayBuffer(72)) };
+        I.data[0] = I.data[4] = I.data[8] = 1;
+        const A = { rows: 2, cols: 3, data: Float64Array.of(1, 2, 3, 4, 5, 6) };
+
+        const C = await tasklets.matmul(A, I);
+        const D = await tasklets.matmul(C, I);
+
+        expect(Array.from(D.data)).toEqual([1, 2, 3, 4, 5, 6]);
+    });
+
+    test('should reject mismatched shapes and element types', async () => {
+        await expect(tasklets.matmul(matrix(2, 3), matrix(2, 3))).rejects.toThrow('Cannot multiply 2x3 by 2x3');
+        await expect(tasklets.matmul(matrix(2, 3), matrix(3, 2, Float32Array))).rejects.toThrow('same element type');
+        await expect(tasklets.matmul({ rows: 2, cols: 2, data: [1, 2, 3, 4] }, matrix(2, 2))).rejects.toThrow('Float64Array or Float32Array');
+        await expect(tasklets.matmul({ rows: 2, cols: 3, data: new Float64Array(5) }, matrix(3, 2))).rejects.toThrow('rows x cols');
+    });
+});
@@ -0,0 +1,64 @@
+const Tasklets = require('../../lib/index');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+describe('MODULE: Task Resolution', () => {
+    let tasklets;
+    const namedModule = path.join(__dirname, 'named-module.cjs');
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should run a named export with MODULE:path#fn', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none' });
+
+        await expect(tasklets.run(`MODULE:${namedModule}#multiply`, 6, 7)).resolves.toBe(42);
+        await expect(tasklets.run(`MODULE:${namedModule}#negate`, 3)).resolves.toBe(-3);
+    });
+
+    test('should reject exports that are not functions', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none' });
+
+        await expect(tasklets.run(`MODULE:${namedModule}#version`))
+            .rejects.toThrow("has no exported function 'version'");
+        await expect(tasklets.run(`MODULE:${namedModule}`))
+            .rejects.toThrow("has no exported function 'module.exports'");
+    });
+
+    test('should match allowlist entries by resolved path', async () => {
+        // Same file, spelled with a redundant segment
+        const entry = `${__dirname}/../js/./named-module.cjs`;
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none', allowedModules: [entry] });
+
+        await expect(tasklets.run(`MODULE:${namedModule}#multiply`, 2, 3)).resolves.toBe(6);
+    });
+
+    test('should allow every module below an allowlisted directory', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none', allowedModules: [__dirname] });
+
+        await expect(tasklets.run(`MODULE:${namedModule}#negate`, 1)).resolves.toBe(-1);
+        await expect(tasklets.run(`MODULE:${path.join(__dirname, '..', 'helpers.cjs')}`))
+            .rejects.toThrow('Module loading denied');
+    });
+
+    test('should allow modules below a symlinked allowlisted directory', async () => {
+        const link = path.join(fs.mkdtempSync(path.join(os.tmpdir(), 'tasklets-link-')), 'tasks');
+        fs.symlinkSync(__dirname, link, 'dir');
+        try {
+            tasklets = new Tasklets({ maxWorkers: 1, logging: 'none', allowedModules: [link] });
+
+            await expect(tasklets.run(`MODULE:${path.join(link, 'named-module.cjs')}#negate`, 1)).resolves.toBe(-1);
+            await expect(tasklets.run(`MODULE:${namedModule}#negate`, 2)).resolves.toBe(-2);
+        } finally {
+            fs.rmSync(path.dirname(link), { recursive: true, force: true });
+        }
+    });
+
+    test('should not treat a sibling with a common prefix as inside the directory', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none', allowedModules: [path.join(__dirname, 'named')] });
+
+        await expect(tasklets.run(`MODULE:${namedModule}#negate`, 1)).rejects.toThrow('Module loading denied');
+    });
+});
@@ -0,0 +1,75 @@
+const Tasklets = require('../../lib/index');
+const { philox } = require('../../lib/builtins/montecarlo');
+
+const pi = (random) => {
+    const x = random();
+    const y = random();
+    return x * x + y * y <= 1 ? 4 : 0;
+};
+
+describe('Philox4x32-10', () => {
+    test('should match the Random123 known-answer vectors', () => {
+        const out = new Uint32Array(4);
+
+        philox([0, 0, 0, 0], [0, 0], out);
+        expect(Array.from(out)).toEqual([0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8]);
+
+        philox([0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344], [0xa4093822, 0x299f31d0], out);
+        expect(Array.from(out)).toEqual([0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1]);
+    });
+});
+
+describe('Monte Carlo (monteCarlo)', () => {
+    let tasklets;
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should give bit-identical results for any worker count', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none' });
+        const one = await tasklets.monteCarlo(200000, pi, { seed: 7, chunkSize: 10000 });
+        await tasklets.shutdown();
+
+        tasklets = new Tasklets({ maxWorkers: 4, logging: 'none' });
+        const four = await tasklets.monteCarlo(200000, pi, { seed: 7, chunkSize: 10000 });
+
+        expect(four).toEqual(one);
+        expect(Object.is(four.mean, one.mean)).toBe(true);
+        expect(one.samples).toBe(200000);
+        expect(Math.abs(one.mean - Math.PI)).toBeLessThan(5 * one.stdError);
+    });
+
+    test('should differ across seeds and return a generated seed', async () => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+
+        const a = await tasklets.monteCarlo(50000, pi, { seed: 1 });
+        const b = await tasklets.monteCarlo(50000, pi, { seed: 2 });
+        const unseeded = await tasklets.monteCarlo(50000, pi);
+        const replay = await tasklets.monteCarlo(50000, pi, { seed: unseeded.seed });
+
+        expect(a.mean).not.toBe(b.mean);
+        expect(Number.isSafeInteger(unseeded.seed)).toBe(true);
+        expect(replay).toEqual(unseeded);
+    });
+
+    test('should merge chunk statistics into the overall mean and variance', async () => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+
+        // Index only: values 0..999, a partial last chunk
+        const result = await tasklets.monteCarlo(1000, (random, i) => i, { seed: 0, chunkSize: 300 });
+
+        expect(result.mean).toBeCloseTo(499.5, 9);
+        expect(result.variance).toBeCloseTo(1000 * 1001 / 12, 6);
+    });
+
+    test('should reject when fn throws or returns a non-number', async () => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+
+        await expect(tasklets.monteCarlo(1000, () => { throw new Error('model diverged'); }))
+            .rejects.toThrow('model diverged');
+        await expect(tasklets.monteCarlo(1000, () => 'x')).rejects.toThrow('must return a number');
+        await expect(tasklets.monteCarlo(0, pi)).rejects.toThrow('samples must be a positive integer');
+        await expect(tasklets.monteCarlo(10, pi, { seed: -1 })).rejects.toThrow('seed must be');
+    });
+});
@@ -0,0 +1,3 @@
+exports.multiply = (a, b) => a * b;
+exports.negate = (a) => -a;
+exports.version = 1;
@@ -49,6 +49,43 @@ describe('Performance Monitoring Tests', () => {
       expect(stats.avgTaskTime).toBeDefined();
     });
 
+    test('should report worker-side wall and CPU time per task', async () => {
+      await tasklets.run(() => {
+        const end = Date.now() + 30;
+        while (Date.now() < end) { /* busy */ }
+      });
+
+      const stats = tasklets.getStats();
+      expect(stats.avgTaskTime).toBeGreaterThanOrEqual(25);
+      if (stats.avgCpuTime !== null) {
+        expect(stats.avgCpuTime).toBeGreaterThan(10);
+        expect(stats.avgCpuTime).toBeLessThanOrEqual(stats.avgTaskTime + 1);
+      }
+    });
+
+    test('should aggregate completions recorded by workers in shared memory', async () => {
+      await tasklets.runAll([
+        () => 1,
+        () => 2,
+        () => { throw new Error('fail'); }
+      ]);
+
+      const stats = tasklets.getStats();
+      expect(stats.processedTasks).toBe(3);
+      expect(stats.failedTasks).toBe(1);
+      expect(stats.taskTimePercentiles.p50).toBeGreaterThan(0);
+      expect(stats.taskTimePercentiles.p99).toBeGreaterThanOrEqual(stats.taskTimePercentiles.p50);
+    });
+
+    test('should keep totals when workers are replaced', async () => {
+      await tasklets.run(() => 1);
+      await tasklets.workerPool[0].worker.terminate();
+      tasklets.workerPool = [];
+
+      await tasklets.run(() => 2);
+      expect(tasklets.getStats().processedTasks).toBe(2);
+    });
+
     test('should handle configuration changes in stats', () => {
       tasklets.configure({
         maxWorkers: 4,
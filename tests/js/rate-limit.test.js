@@ -0,0 +1,118 @@
+const Tasklets = require('../../lib/index');
+const RateLimitManager = require('../../lib/ratelimit');
+
+const work = (n) => n;
+
+describe('Rate Limiting', () => {
+    let tasklets;
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should hold tasks of a limited type until tokens are available', async () => {
+        tasklets = new Tasklets({
+            maxWorkers: 2,
+            logging: 'none',
+            rateLimit: { perType: { work: { rate: 20, burst: 1 } } }
+        });
+
+        const start = Date.now();
+        const results = await Promise.all([1, 2, 3, 4, 5].map(n => tasklets.run(work, n)));
+
+        expect(results).toEqual([1, 2, 3, 4, 5]);
+        // 1 token up-front, then one every 50ms
+        expect(Date.now() - start).toBeGreaterThanOrEqual(180);
+
+        const stats = tasklets.getStats().rateLimits.types.work;
+        expect(stats.admitted).toBe(5);
+        expect(stats.held).toBe(4);
+    });
+
+    test('should refund the token of a task whose args cannot be cloned', async () => {
+        tasklets = new Tasklets({
+            maxWorkers: 1,
+            logging: 'none',
+            rateLimit: { perType: { work: { rate: 1, burst: 1 } } }
+        });
+
+        await expect(tasklets.run(work, { f: () => 1 })).rejects.toThrow();
+        const start = Date.now();
+        await expect(tasklets.run(work, 2)).resolves.toBe(2);
+
+        expect(Date.now() - start).toBeLessThan(500);
+        expect(tasklets.getStats().rateLimits.types.work.admitted).toBe(1);
+    });
+
+    test('should accept a rateLimit on the task descriptor', async () => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+
+        const start = Date.now();
+        await Promise.all([1, 2, 3].map(n => tasklets.run({ task: work, args: [n], rateLimit: { rate: 10, burst: 1 } })));
+
+        expect(Date.now() - start).toBeGreaterThanOrEqual(180);
+        expect(tasklets.getStats().rateLimits.types.work.rate).toBe(10);
+    });
+
+    test('should let unlimited work pass held tasks', async () => {
+        tasklets = new Tasklets({
+            maxWorkers: 2,
+            logging: 'none',
+            rateLimit: { perTenant: { '*': { rate: 5, burst: 1 } } }
+        });
+
+        const slowTenant = [1, 2, 3, 4].map(n => tasklets.run({ task: work, args: [n], tenant: 'a' }));
+        await new Promise(r => setTimeout(r, 20));
+
+        const start = Date.now();
+        await expect(tasklets.run({ task: work, args: ['b'], tenant: 'b' })).resolves.toBe('b');
+        expect(Date.now() - start).toBeLessThan(150);
+
+        await Promise.all(slowTenant);
+        const tenants = tasklets.getStats().rateLimits.tenants;
+        expect(tenants.a.admitted).toBe(4);
+        expect(tenants.b.admitted).toBe(1);
+    });
+
+    test('should not rescan held tasks for every dispatch', async () => {
+        tasklets = new Tasklets({
+            maxWorkers: 2,
+            logging: 'none',
+            rateLimit: { perType: { work: { rate: 1, burst: 1 } } }
+        });
+        const other = (n) => n;
+
+        const held = Array.from({ length: 500 }, (_, n) => tasklets.run(work, n).catch(() => { }));
+        let checks = 0;
+        const heldBy = tasklets.rateLimitManager.heldBy.bind(tasklets.rateLimitManager);
+        tasklets.rateLimitManager.heldBy = (task, now) => { checks++; return heldBy(task, now); };
+
+        for (let n = 0; n < 200; n++) await tasklets.run(other, n);
+
+        expect(checks).toBeLessThan(2000);
+        expect(tasklets.getStats().queuedTasks).toBe(499);
+        await tasklets.terminate();
+        await Promise.all(held);
+    });
+
+    test('should evict idle buckets of wildcard tenants', () => {
+        const limits = new RateLimitManager(null);
+        limits.configure({ perTenant: { '*': { rate: 10, burst: 1 }, vip: 5 } }, 0);
+
+        for (let i = 0; i < 1000; i++) {
+            const task = { type: 'work', tenant: `tenant-${i}` };
+            expect(limits.heldBy(task, i * 200)).toBe(null);
+            limits.take(task);
+        }
+
+        expect(limits.tenantBuckets.size).toBeLessThan(100);
+        expect(limits.tenantBuckets.has('vip')).toBe(true);
+        expect(limits.tenantBuckets.has('tenant-999')).toBe(true);
+    });
+
+    test('should reject an invalid rate', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none' });
+        await expect(tasklets.run({ task: work, args: [1], rateLimit: { rate: 0 } }))
+            .rejects.toThrow('rateLimit rate must be a positive number');
+    });
+});
@@ -0,0 +1,100 @@
+const Tasklets = require('../../lib/index');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const sleep = (ms) => new Promise(r => setTimeout(r, ms));
+
+describe('Module Hot Reload', () => {
+    let tasklets;
+    let tmpDir;
+    let cjsPath;
+    let esmPath;
+
+    const writeVersion = (version) => {
+        fs.writeFileSync(cjsPath, `module.exports = async (ms) => { await new Promise(r => setTimeout(r, ms || 0)); return ${version}; };\n`);
+        fs.writeFileSync(esmPath, `export const version = () => ${version};\n`);
+    };
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+        tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'tasklets-reload-'));
+        cjsPath = path.join(tmpDir, 'task.cjs');
+        esmPath = path.join(tmpDir, 'task.mjs');
+        writeVersion(1);
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+        fs.rmSync(tmpDir, { recursive: true, force: true });
+    });
+
+    test('should roll workers so new tasks load the updated module', async () => {
+        await Promise.all([tasklets.run(`MODULE:${cjsPath}`, 20), tasklets.run(`MODULE:${cjsPath}`, 20)]);
+        expect(tasklets.getStats().totalWorkers).toBe(2);
+
+        writeVersion(2);
+        const summary = await tasklets.reloadModule(cjsPath);
+
+        expect(summary).toEqual({ mode: 'roll', workers: 2 });
+        expect(tasklets.getStats().totalWorkers).toBe(2);
+        const results = await Promise.all([tasklets.run(`MODULE:${cjsPath}`, 20), tasklets.run(`MODULE:${cjsPath}`, 20)]);
+        expect(results).toEqual([2, 2]);
+    });
+
+    test('should keep capacity and let in-flight tasks finish during a roll', async () => {
+        await Promise.all([tasklets.run(`MODULE:${cjsPath}`), tasklets.run(`MODULE:${cjsPath}`)]);
+        const inFlight = tasklets.run(`MODULE:${cjsPath}`, 150);
+
+        writeVersion(2);
+        let minWorkers = Infinity;
+        const sampler = setInterval(() => {
+            minWorkers = Math.min(minWorkers, tasklets.getStats().totalWorkers);
+        }, 5);
+        const reloaded = tasklets.reloadModule(`MODULE:${cjsPath}`);
+
+        await sleep(20);
+        await expect(tasklets.run(`MODULE:${cjsPath}`)).resolves.toBe(2);
+        await expect(inFlight).resolves.toBe(1);
+        await reloaded;
+        clearInterval(sampler);
+
+        expect(minWorkers).toBeGreaterThanOrEqual(2);
+    });
+
+    test('should replace every busy worker at once during a roll', async () => {
+        await Promise.all([tasklets.run(`MODULE:${cjsPath}`), tasklets.run(`MODULE:${cjsPath}`)]);
+        const inFlight = [tasklets.run(`MODULE:${cjsPath}`, 150), tasklets.run(`MODULE:${cjsPath}`, 150)];
+
+        writeVersion(2);
+        const reloaded = tasklets.reloadModule(cjsPath);
+        expect(tasklets.getStats().totalWorkers).toBe(4);
+
+        await expect(Promise.all([tasklets.run(`MODULE:${cjsPath}`), tasklets.run(`MODULE:${cjsPath}`)])).resolves.toEqual([2, 2]);
+        await expect(Promise.all(inFlight)).resolves.toEqual([1, 1]);
+        await expect(reloaded).resolves.toEqual({ mode: 'roll', workers: 2 });
+        expect(tasklets.getStats().totalWorkers).toBe(2);
+    });
+
+    test('should invalidate a CommonJS module in place', async () => {
+        await expect(tasklets.run(`MODULE:${cjsPath}`)).resolves.toBe(1);
+
+        writeVersion(3);
+        await expect(tasklets.reloadModule(cjsPath, { mode: 'invalidate' })).resolves.toEqual({ mode: 'invalidate', workers: 1 });
+
+        await expect(tasklets.run(`MODULE:${cjsPath}`)).resolves.toBe(3);
+    });
+
+    test('should invalidate an ES module in place', async () => {
+        await expect(tasklets.run(`ESM:${esmPath}#version`)).resolves.toBe(1);
+
+        writeVersion(4);
+        await tasklets.reloadModule(`ESM:${esmPath}#version`, { mode: 'invalidate' });
+
+        await expect(tasklets.run(`ESM:${esmPath}#version`)).resolves.toBe(4);
+    });
+
+    test('should reject an unknown mode', async () => {
+        await expect(tasklets.reloadModule(cjsPath, { mode: 'bounce' })).rejects.toThrow('Unknown reload mode: bounce');
+    });
+});
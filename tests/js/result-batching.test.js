@@ -0,0 +1,89 @@
+const Tasklets = require('../../lib/index');
+
+describe('Result Batching', () => {
+    let tasklets;
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should deliver every result, several per batch under load', async () => {
+        tasklets = new Tasklets({ maxWorkers: 4, logging: 'none', resultBatching: true });
+
+        const results = await Promise.all(Array.from({ length: 400 }, (_, i) => tasklets.run((x) => x * 2, i)));
+
+        expect(results).toEqual(Array.from({ length: 400 }, (_, i) => i * 2));
+        const stats = tasklets.getStats().resultBatching;
+        expect(stats.delivered).toBe(400);
+        expect(stats.batches).toBeLessThan(400);
+        expect(stats.avgBatch).toBeGreaterThan(1);
+        expect(tasklets.getStats().config.resultBatching).toEqual({ maxBatch: 256 });
+    });
+
+    test('should settle results only after the I/O turn, in one batch', async () => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none', resultBatching: true });
+        await tasklets.runAll([() => 1, () => 2]); // warm up both workers
+
+        const order = [];
+        const slow = (ms) => { const end = Date.now() + ms; while (Date.now() < end); return ms; };
+        const tasks = [tasklets.run(slow, 20), tasklets.run(slow, 20)].map(p => p.then(v => order.push(v)));
+        await Promise.all(tasks);
+
+        expect(order).toEqual([20, 20]);
+        expect(tasklets.getStats().resultBatching.largestBatch).toBeGreaterThanOrEqual(1);
+    });
+
+    test('should cap a batch at maxBatch', async () => {
+        tasklets = new Tasklets({ maxWorkers: 4, logging: 'none', resultBatching: { maxBatch: 2 } });
+
+        await Promise.all(Array.from({ length: 100 }, (_, i) => tasklets.run((x) => x, i)));
+
+        expect(tasklets.getStats().resultBatching.largestBatch).toBeLessThanOrEqual(2);
+    });
+
+    test('should wait for pending deliveries before draining', async () => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none', resultBatching: true });
+
+        let settled = 0;
+        const tasks = Array.from({ length: 20 }, (_, i) => tasklets.run((x) => x, i).then(() => settled++));
+        await tasklets.drain();
+        await Promise.resolve();
+
+        expect(settled).toBe(20);
+        await Promise.all(tasks);
+    });
+
+    test('should deliver the rest of a batch after a callback throws', async () => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none', resultBatching: { maxBatch: 64 } });
+
+        const uncaught = [];
+        const onUncaught = (err) => uncaught.push(err.message);
+        const listeners = process.listeners('uncaughtException');
+        process.removeAllListeners('uncaughtException');
+        process.on('uncaughtException', onUncaught);
+
+        let delivered = 0;
+        try {
+            await new Promise((resolve) => {
+                for (let i = 0; i < 10; i++) {
+                    tasklets.submit((x) => x, [i], () => {
+                        if (++delivered === 10) resolve();
+                        if (i === 0) throw new Error('callback bug');
+                    });
+                }
+            });
+        } finally {
+            process.removeListener('uncaughtException', onUncaught);
+            listeners.forEach(l => process.on('uncaughtException', l));
+        }
+
+        expect(delivered).toBe(10);
+        expect(uncaught).toEqual(['callback bug']);
+    });
+
+    test('should reject an invalid maxBatch', () => {
+        tasklets = new Tasklets({ logging: 'none' });
+        expect(() => tasklets.configure({ resultBatching: { maxBatch: 0 } }))
+            .toThrow('resultBatching maxBatch must be a positive integer');
+    });
+});
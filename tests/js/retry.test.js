@@ -0,0 +1,123 @@
+const Tasklets = require('../../lib/index');
+
+// Fails until it has been called `failures` times; the counter lives in a
+// SharedArrayBuffer so every attempt sees it, whichever worker runs it.
+const flaky = (counter, failures) => {
+    const calls = Atomics.add(new Int32Array(counter), 0, 1) + 1;
+    if (calls <= failures) throw new Error(`flaky failure ${calls}`);
+    return calls;
+};
+
+describe('Scheduler Retries', () => {
+    let tasklets;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('retry() should pass args to every attempt', async () => {
+        const counter = new SharedArrayBuffer(4);
+
+        const result = await tasklets.retry(flaky, { args: [counter, 2], attempts: 3, delay: 5 });
+
+        expect(result).toBe(3);
+        expect(tasklets.getStats().retries.types.flaky).toEqual({
+            calls: 1,
+            retries: 2,
+            recovered: 1,
+            exhausted: 0,
+            budgetDenied: 0
+        });
+    });
+
+    test('run() should honour a retry policy on the task descriptor', async () => {
+        const counter = new SharedArrayBuffer(4);
+
+        await expect(tasklets.run({ task: flaky, args: [counter, 5], retry: { attempts: 2 } }))
+            .rejects.toThrow('flaky failure 2');
+        expect(tasklets.getStats().retries.types.flaky.exhausted).toBe(1);
+    });
+
+    test('should count a retried task once in totalTasks', async () => {
+        const counter = new SharedArrayBuffer(4);
+        await tasklets.retry(flaky, { args: [counter, 1] });
+        expect(tasklets.getStats().totalTasks).toBe(1);
+    });
+
+    test('should follow delay * backoff^n when jitter is disabled', async () => {
+        const delays = [];
+        tasklets.on('task:retry', (info) => delays.push(info.delay));
+        const counter = new SharedArrayBuffer(4);
+
+        await tasklets.retry(flaky, { args: [counter, 2], attempts: 3, delay: 10, backoff: 2, jitter: false });
+
+        expect(delays).toEqual([10, 20]);
+    });
+
+    test('should keep jittered delays between the base delay and maxDelay', async () => {
+        const delays = [];
+        tasklets.on('task:retry', (info) => delays.push(info.delay));
+        const counter = new SharedArrayBuffer(4);
+
+        await tasklets.run({ task: flaky, args: [counter, 3], retry: { attempts: 4, baseDelay: 5, maxDelay: 40 } });
+
+        expect(delays).toHaveLength(3);
+        for (const delay of delays) {
+            expect(delay).toBeGreaterThanOrEqual(5);
+            expect(delay).toBeLessThanOrEqual(40);
+        }
+    });
+
+    test('should move a retry to another worker when the pool can grow', async () => {
+        const counter = new SharedArrayBuffer(4);
+        expect(tasklets.getStats().totalWorkers).toBe(0);
+
+        await tasklets.retry(flaky, { args: [counter, 1] });
+
+        expect(tasklets.getStats().totalWorkers).toBe(2);
+    });
+
+    test('should stop retrying once the retry budget is spent', async () => {
+        tasklets.configure({ retry: { budget: 0, minRetriesPerWindow: 0 } });
+        const counter = new SharedArrayBuffer(4);
+
+        await expect(tasklets.retry(flaky, { args: [counter, 1], attempts: 3 }))
+            .rejects.toThrow('flaky failure 1');
+        expect(tasklets.getStats().retries.types.flaky.budgetDenied).toBe(1);
+    });
+
+    test('retry() should jitter its waits by default', async () => {
+        const delays = [];
+        tasklets.on('task:retry', (info) => delays.push(info.delay));
+        const counter = new SharedArrayBuffer(4);
+
+        await tasklets.retry(flaky, { args: [counter, 6], attempts: 7, delay: 10 });
+
+        expect(delays).toHaveLength(6);
+        expect(new Set(delays).size).toBeGreaterThan(1);
+        delays.forEach(d => {
+            expect(d).toBeGreaterThanOrEqual(10);
+            expect(d).toBeLessThanOrEqual(30);
+        });
+    });
+
+    test('retry() should not be limited by the default budget', async () => {
+        const loops = Array.from({ length: 6 }, () => {
+            const own = new SharedArrayBuffer(4);
+            return tasklets.retry(flaky, { args: [own, 3], attempts: 4 });
+        });
+
+        await expect(Promise.all(loops)).resolves.toEqual([4, 4, 4, 4, 4, 4]);
+        expect(tasklets.getStats().retries.types.flaky.budgetDenied).toBe(0);
+    });
+
+    test('should count every first attempt as budget traffic', async () => {
+        await tasklets.runAll([() => 1, () => 2, () => 3]);
+
+        expect(tasklets.getStats().retries.window.requests).toBe(3);
+    });
+});
@@ -0,0 +1,118 @@
+const Tasklets = require('../../lib/index');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const collect = async (iterable) => {
+    const out = [];
+    for await (const m of iterable) out.push(m);
+    return out;
+};
+
+const expected = (text, re) => [...text.matchAll(re)].map(m => ({ offset: m.index, match: m[0] }));
+
+const LOG = Array.from({ length: 3000 }, (_, i) => `${i} ${i % 5 === 0 ? 'ERROR' : 'INFO'} request=${i % 13}`).join('\n');
+
+describe('Parallel Regex Scan', () => {
+    let tasklets;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 3, logging: 'none' });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should yield every match of a buffer in order with byte offsets', async () => {
+        const matches = await collect(tasklets.scan(Buffer.from(LOG), /ERROR request=\d+/, { chunkSize: 4096 }));
+
+        expect(matches).toEqual(expected(LOG, /ERROR request=\d+/g));
+    });
+
+    test('should find matches that span lines with overlapping chunks, without duplicates', async () => {
+        const re = /request=1\n\d+ ERROR/g;
+        const matches = await collect(tasklets.scan(Buffer.from(LOG), re, { chunkSize: 1000, overlap: 32 }));
+
+        expect(matches).toEqual(expected(LOG, re));
+        expect(matches.length).toBeGreaterThan(0);
+    });
+
+    test('should not report the tail of a match that crosses a chunk edge', async () => {
+        const text = 'hello world foobar bazqux';
+        const matches = await collect(tasklets.scan(Buffer.from(text), /\w+/, { chunkSize: 3, overlap: 10 }));
+
+        expect(matches).toEqual(expected(text, /\w+/g));
+    });
+
+    test('should match matchAll for word patterns over many small overlapping chunks', async () => {
+        const text = LOG.slice(0, 5000);
+        const matches = await collect(tasklets.scan(Buffer.from(text), /\w+/, { chunkSize: 7, overlap: 16 }));
+
+        expect(matches).toEqual(expected(text, /\w+/g));
+    });
+
+    test('should see the text before a chunk for word boundaries, anchors and lookbehinds', async () => {
+        expect(await collect(tasklets.scan(Buffer.from('xxfoo foo'), /\bfoo/, { chunkSize: 2, overlap: 4 })))
+            .toEqual([{ offset: 6, match: 'foo' }]);
+
+        const text = LOG.slice(0, 3000);
+        for (const re of [/(?<=ERROR )request=\d/g, /(?<!\d)[13]\b/g, /^\d+ INFO/gm]) {
+            expect(await collect(tasklets.scan(Buffer.from(text), re, { chunkSize: 5, overlap: 12 })))
+                .toEqual(expected(text, re));
+        }
+        expect(await collect(tasklets.scan(Buffer.from(text), /^\d+/, { chunkSize: 64 })))
+            .toEqual(expected(text, /^\d+/g));
+    });
+
+    test('should scan a file with UTF-8 byte offsets', async () => {
+        const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'tasklets-scan-'));
+        const file = path.join(dir, 'app.log');
+        const text = Array.from({ length: 500 }, (_, i) => `ação ${i} ✓ usuário=${i % 4}`).join('\n');
+        fs.writeFileSync(file, text);
+        try {
+            const matches = await collect(tasklets.scan(file, 'usuário=3', { chunkSize: 777, encoding: 'utf8' }));
+
+            const bytes = Buffer.from(text);
+            const offsets = [];
+            for (let i = bytes.indexOf('usuário=3'); i !== -1; i = bytes.indexOf('usuário=3', i + 1)) offsets.push(i);
+            expect(matches.map(m => m.offset)).toEqual(offsets);
+            expect(matches.every(m => m.match === 'usuário=3')).toBe(true);
+
+            const after = await collect(tasklets.scan(file, /(?<=✓ )\p{L}+/u, { chunkSize: 9, overlap: 8, encoding: 'utf8' }));
+            expect(after.length).toBe(500);
+            expect(after.every(m => m.match === 'usuário' && bytes.toString('utf8', m.offset - 4, m.offset) === '✓ ')).toBe(true);
+        } finally {
+            fs.rmSync(dir, { recursive: true, force: true });
+        }
+    });
+
+    test('should share input that lives in a SharedArrayBuffer', async () => {
+        const source = Buffer.from(LOG);
+        const input = new Uint8Array(new SharedArrayBuffer(source.length));
+        input.set(source);
+
+        const matches = await collect(tasklets.scan(input, /INFO request=12/, { chunkSize: 2048 }));
+
+        expect(matches).toEqual(expected(LOG, /INFO request=12/g));
+    });
+
+    test('should cancel the remaining chunks when iteration stops early', async () => {
+        const input = Buffer.from(LOG.repeat(20));
+        const first = [];
+        for await (const m of tasklets.scan(input, /ERROR/, { chunkSize: 1024, concurrency: 2 })) {
+            first.push(m);
+            if (first.length === 3) break;
+        }
+
+        expect(first.map(m => m.offset)).toEqual(expected(LOG, /ERROR/g).slice(0, 3).map(m => m.offset));
+        expect(tasklets.getStats().queuedTasks).toBe(0);
+    });
+
+    test('should validate its arguments', async () => {
+        await expect(collect(tasklets.scan(Buffer.from('x'), /x/, { chunkSize: 0 })))
+            .rejects.toThrow('chunkSize must be a positive integer');
+        await expect(collect(tasklets.scan(42, /x/))).rejects.toThrow('Input must be a Buffer, a Uint8Array or a file path');
+        await expect(collect(tasklets.scan('/no/such/file.log', /x/))).rejects.toThrow('ENOENT');
+    });
+});
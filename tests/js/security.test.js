@@ -1,5 +1,6 @@
 const Tasklets = require('../../lib/index');
 const path = require('path');
+const { Worker, MessageChannel } = require('worker_threads');
 
 describe('Security Monitoring Tests', () => {
     let tasklets;
@@ -39,4 +40,33 @@ describe('Security Monitoring Tests', () => {
         const result = await tasklets.run(`MODULE:${dummyModulePath}`, 5, 5);
         expect(result).toBe(10);
     });
+
+    test('should ignore tasks posted to a worker outside the private channel', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none' });
+        await tasklets.run(() => 'warm');
+
+        const flag = new SharedArrayBuffer(4);
+        tasklets.workerPool[0].worker.postMessage({
+            taskId: 999,
+            task: '(flag) => Atomics.store(new Int32Array(flag), 0, 1)',
+            args: [flag]
+        });
+        await new Promise(r => setTimeout(r, 100));
+
+        expect(Atomics.load(new Int32Array(flag), 0)).toBe(0);
+        await expect(tasklets.run(() => 'still serving')).resolves.toBe('still serving');
+    });
+
+    test('should refuse a handshake with the wrong secret', async () => {
+        tasklets = null;
+        const worker = new Worker(path.join(__dirname, '..', '..', 'lib', 'worker.js'), {
+            workerData: { secret: 'a'.repeat(64) }
+        });
+        const { port2 } = new MessageChannel();
+        worker.postMessage({ type: 'handshake', secret: 'b'.repeat(64), port: port2 }, [port2]);
+
+        const error = await new Promise(resolve => worker.once('error', resolve));
+        expect(error.message).toContain('Authentication failed');
+        await worker.terminate();
+    });
 });
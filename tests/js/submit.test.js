@@ -0,0 +1,88 @@
+const Tasklets = require('../../lib/index');
+
+const submit = (pool, task, args) => new Promise((resolve) => {
+    pool.submit(task, args, (err, result) => resolve({ err, result }));
+});
+
+describe('Callback submission', () => {
+    let tasklets;
+
+    beforeEach(() => {
+        tasklets = new Tasklets({ maxWorkers: 2, logging: 'none' });
+    });
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should call back with the result', async () => {
+        const { err, result } = await submit(tasklets, (a, b) => a + b, [2, 3]);
+        expect(err).toBeNull();
+        expect(result).toBe(5);
+    });
+
+    test('should call back with the task error', async () => {
+        const { err } = await submit(tasklets, () => { throw new Error('boom'); });
+        expect(err).toBeInstanceOf(Error);
+        expect(err.message).toBe('boom');
+    });
+
+    test('should accept a task configuration object', async () => {
+        const { result } = await submit(tasklets, { task: (x) => x * 2, args: [21], name: 'double' });
+        expect(result).toBe(42);
+    });
+
+    test('should never call back synchronously, even for early errors', async () => {
+        let called = false;
+        tasklets.submit('not a task', undefined, () => { called = true; });
+        tasklets.submit(42, undefined, () => { called = true; });
+        expect(called).toBe(false);
+
+        const { err } = await submit(tasklets, 42);
+        expect(err.message).toBe('Task must be a function or a string');
+    });
+
+    test('should report uncloneable args without leaking the worker', async () => {
+        const { err } = await submit(tasklets, (x) => x, [() => 1]);
+        expect(err).toBeInstanceOf(Error);
+
+        await expect(tasklets.run(() => 'still works')).resolves.toBe('still works');
+        expect(tasklets.getStats().activeTasks).toBe(0);
+    });
+
+    test('should call back asynchronously when args cannot be cloned', async () => {
+        let called = false;
+        const done = new Promise((resolve) => {
+            tasklets.submit((x) => x, [{ f: () => 1 }], (err) => {
+                called = true;
+                resolve(err);
+            });
+        });
+
+        expect(called).toBe(false);
+        await expect(done).resolves.toBeInstanceOf(Error);
+    });
+
+    test('should keep the worker usable when a callback throws', async () => {
+        const uncaught = [];
+        const onUncaught = (err) => uncaught.push(err.message);
+        const listeners = process.listeners('uncaughtException');
+        process.removeAllListeners('uncaughtException');
+        process.on('uncaughtException', onUncaught);
+
+        try {
+            tasklets.submit(() => 1, undefined, () => { throw new Error('callback bug'); });
+            await new Promise(r => setTimeout(r, 200));
+        } finally {
+            process.removeListener('uncaughtException', onUncaught);
+            listeners.forEach(l => process.on('uncaughtException', l));
+        }
+
+        expect(uncaught).toEqual(['callback bug']);
+        await expect(tasklets.run(() => 'next')).resolves.toBe('next');
+    });
+
+    test('should require a callback', () => {
+        expect(() => tasklets.submit(() => 1, [])).toThrow('submit() requires a callback function');
+    });
+});
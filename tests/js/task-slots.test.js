@@ -0,0 +1,54 @@
+const TaskSlots = require('../../lib/slots');
+
+describe('TaskSlots', () => {
+    test('should store and release records by ID', () => {
+        const slots = new TaskSlots(4);
+        const a = { name: 'a' };
+        const id = slots.acquire(a);
+
+        expect(slots.get(id)).toBe(a);
+        expect(slots.size).toBe(1);
+        expect(slots.release(id)).toBe(true);
+        expect(slots.get(id)).toBeUndefined();
+        expect(slots.size).toBe(0);
+    });
+
+    test('should reuse slots with a new generation so stale IDs miss', () => {
+        const slots = new TaskSlots(4);
+        const first = slots.acquire({ name: 'first' });
+        slots.release(first);
+
+        const second = slots.acquire({ name: 'second' });
+        expect(second).not.toBe(first);
+        expect(second & 0xFFFFF).toBe(first & 0xFFFFF); // same slot
+        expect(slots.get(first)).toBeUndefined();
+        expect(slots.release(first)).toBe(false);
+        expect(slots.get(second).name).toBe('second');
+    });
+
+    test('should grow past the initial capacity and keep IDs small integers', () => {
+        const slots = new TaskSlots(2);
+        const ids = Array.from({ length: 100 }, (_, i) => slots.acquire({ i }));
+
+        expect(slots.size).toBe(100);
+        ids.forEach((id, i) => {
+            expect(Number.isInteger(id) && id >= 0 && id < 2 ** 31).toBe(true);
+            expect(slots.get(id).i).toBe(i);
+        });
+    });
+
+    test('forEach should visit live records and tolerate release during iteration', () => {
+        const slots = new TaskSlots(4);
+        const ids = [1, 2, 3].map(n => slots.acquire({ n }));
+        slots.release(ids[1]);
+
+        const seen = [];
+        slots.forEach((record, id) => {
+            seen.push(record.n);
+            slots.release(id);
+        });
+
+        expect(seen).toEqual([1, 3]);
+        expect(slots.size).toBe(0);
+    });
+});
@@ -0,0 +1,105 @@
+const Tasklets = require('../../lib/index');
+
+// Busy loop for `ms`, yielding at every checkpoint
+const longTask = async (ms) => {
+    const start = Date.now();
+    while (Date.now() - start < ms) {
+        for (let i = 0; i < 1e4; i++);
+        await tasklet.yield();
+    }
+    return { start, end: Date.now() };
+};
+
+describe('Cooperative Time Slicing', () => {
+    let tasklets;
+
+    afterEach(async () => {
+        await tasklets.shutdown();
+    });
+
+    test('should interleave a short task with a long sliced task on one worker', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none', timeSlicing: { quantumMs: 5 } });
+
+        const long = tasklets.run({ task: longTask, args: [300], sliced: true });
+        await new Promise(r => setTimeout(r, 30));
+
+        const start = Date.now();
+        await expect(tasklets.run(() => 'short')).resolves.toBe('short');
+        expect(Date.now() - start).toBeLessThan(150);
+
+        await long;
+        expect(tasklets.getStats().totalWorkers).toBe(1);
+    });
+
+    test('should run several sliced tasks round-robin', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none', timeSlicing: { maxConcurrentPerWorker: 2, quantumMs: 5 } });
+
+        const [a, b] = await Promise.all([
+            tasklets.run({ task: longTask, args: [150], sliced: true }),
+            tasklets.run({ task: longTask, args: [150], sliced: true })
+        ]);
+
+        expect(b.start).toBeLessThan(a.end);
+        expect(a.start).toBeLessThan(b.end);
+    });
+
+    test('should not share a worker that runs a non-sliced task', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none', timeSlicing: true });
+
+        const first = tasklets.run(longTask, 100);
+        await new Promise(r => setTimeout(r, 20));
+        tasklets.run({ task: longTask, args: [10], sliced: true });
+
+        expect(tasklets.getStats().queuedTasks).toBe(1);
+        await first;
+    });
+
+    test('should cancel a timed-out sliced task without failing its neighbours', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none', timeout: 200, timeSlicing: { quantumMs: 5 } });
+        const stubborn = async () => {
+            for (;;) {
+                tasklet.throwIfCancelled();
+                await tasklet.yield();
+            }
+        };
+
+        const slow = tasklets.run({ task: stubborn, sliced: true });
+        await new Promise(r => setTimeout(r, 250));
+        const neighbour = tasklets.run({ task: longTask, args: [100], sliced: true });
+        tasklets._maintenance();
+
+        await expect(slow).rejects.toThrow('Task timed out after 200ms');
+        await expect(neighbour).resolves.toEqual(expect.objectContaining({ start: expect.any(Number) }));
+        expect(tasklets.getStats().totalWorkers).toBe(1);
+        expect(tasklets.getStats().recovery.requeued).toBe(0);
+    });
+
+    test('should requeue the neighbours of a timed-out task that ignores cancellation', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none', timeout: 200, timeSlicing: { quantumMs: 5 } });
+        const deaf = async () => {
+            for (;;) await tasklet.yield();
+        };
+
+        const slow = tasklets.run({ task: deaf, sliced: true });
+        await new Promise(r => setTimeout(r, 250));
+        const neighbour = tasklets.run({ task: longTask, args: [100], sliced: true });
+        tasklets._maintenance();
+        await expect(slow).rejects.toThrow('Task timed out after 200ms');
+        await new Promise(r => setTimeout(r, 20));
+        tasklets._maintenance();
+
+        await expect(neighbour).resolves.toEqual(expect.objectContaining({ start: expect.any(Number) }));
+        expect(tasklets.getStats().recovery.requeued).toBe(1);
+    });
+
+    test('should keep one task per worker when disabled', async () => {
+        tasklets = new Tasklets({ maxWorkers: 1, logging: 'none' });
+
+        const long = tasklets.run({ task: longTask, args: [100], sliced: true });
+        tasklets.run(() => 'short');
+
+        expect(tasklets.getStats().queuedTasks).toBe(1);
+        expect(tasklets.getStats().config.timeSlicing).toBeNull();
+        await long;
+    });
+});